@@ -0,0 +1,89 @@
+"""Decode binary trace events recorded with DEBUG_TRACE (see src/utils/trace.h).
+
+The ids of the events are addresses of the F() strings passed to LOG, they
+are looked up in the ELF file of the firmware.
+
+Usage:
+    python .scripts/trace_decode.py firmware.elf capture.bin
+    python .scripts/trace_decode.py firmware.elf /dev/ttyUSB0 --baud 115200
+"""
+import struct
+
+import click
+from elftools.elf.elffile import ELFFile
+
+TRACE_SYNC = 0xA5
+EM_AVR = 'EM_AVR'
+
+
+class Strings:
+    """Null-terminated strings of the allocated sections of an ELF file."""
+
+    def __init__(self, elf):
+        self.sections = []
+        for section in elf.iter_sections():
+            if section['sh_flags'] & 0x2 and section['sh_type'] == 'SHT_PROGBITS':
+                self.sections.append((section['sh_addr'], section.data()))
+        self.cache = {}
+
+    def get(self, address):
+        if address in self.cache:
+            return self.cache[address]
+        text = None
+        for start, data in self.sections:
+            if start <= address < start + len(data):
+                end = data.find(b'\0', address - start)
+                text = data[address - start:end].decode('ascii', 'replace')
+                break
+        self.cache[address] = text
+        return text
+
+
+def events(stream, id_size):
+    """Yield (id, arg, timestamp) tuples, skipping bytes until the next sync marker."""
+    body = struct.Struct('<' + ('H' if id_size == 2 else 'I') + 'HI')
+    while True:
+        byte = stream.read(1)
+        if not byte:
+            return
+        if byte[0] != TRACE_SYNC:
+            continue
+        data = stream.read(body.size)
+        if len(data) < body.size:
+            return
+        yield body.unpack(data)
+
+
+def format_arg(arg):
+    chars = ''.join(chr(b) if 32 <= b < 127 else '.' for b in (arg & 0xFF, arg >> 8))
+    signed = arg - 0x10000 if arg & 0x8000 else arg
+    return f'{arg} ({signed}, {signed / 100:.2f}, "{chars}")'
+
+
+@click.command()
+@click.argument('elf', type=click.File('rb'))
+@click.argument('capture')
+@click.option('--baud', default=0, help='Read from a serial port at this baud rate instead of a file.')
+def decode(elf, capture, baud):
+    elf = ELFFile(elf)
+    strings = Strings(elf)
+    id_size = 2 if elf['e_machine'] == EM_AVR else 4
+    if baud:
+        import serial
+        stream = serial.Serial(capture, baud)
+    else:
+        stream = open(capture, 'rb')
+    previous = None
+    for event_id, arg, timestamp in events(stream, id_size):
+        if event_id == 0:
+            click.echo(f'{timestamp:>10} us  -- {arg} events dropped --')
+            continue
+        # AVR keeps F() strings in flash, which is mapped at address 0 of the ELF
+        text = strings.get(event_id) or f'<unknown 0x{event_id:x}>'
+        delta = '' if previous is None else f'+{(timestamp - previous) & 0xFFFFFFFF}'
+        previous = timestamp
+        click.echo(f'{timestamp:>10} us {delta:>8}  {text} {format_arg(arg)}')
+
+
+if __name__ == '__main__':
+    decode()
@@ -0,0 +1,51 @@
+#include <ItemInput.h>
+#include <ItemToggle.h>
+#include <ItemWidget.h>
+#include <LcdMenu.h>
+#include <MenuScreen.h>
+#include <input/KeyboardAdapter.h>
+#include <renderer/AnsiRenderer.h>
+#include <widget/WidgetBar.h>
+#include <widget/WidgetList.h>
+
+// Largest terminal used, a smaller one reported at begin() uses less
+#define TERM_COLS 40
+#define TERM_ROWS 6
+
+void inputCallback(char* value);
+
+static const char* modes[] = {"Auto", "Manual", "Off"};
+
+// clang-format off
+MENU_SCREEN(mainScreen, mainItems,
+    ITEM_BASIC("Start service"),
+    ITEM_INPUT("Name", inputCallback),
+    ITEM_TOGGLE("Backlight", [](bool isOn) {}),
+    ITEM_WIDGET("Mode", [](const char* mode) {}, WIDGET_LIST(modes, 3, 0, "%s", 0, true)),
+    ITEM_WIDGET("Level", [](int level) {}, WIDGET_BAR(10, 1, 0, 40, 8)),
+    ITEM_BASIC("Connect to WiFi"),
+    ITEM_BASIC("Settings"),
+    ITEM_BASIC("Blink SOS"),
+    ITEM_BASIC("Blink random"));
+// clang-format on
+
+// Open the port in a terminal emulator, e.g. `screen /dev/ttyACM0 9600` or PuTTY.
+// The arrow keys, Enter and Esc navigate the menu.
+AnsiRenderer renderer(&Serial, TERM_COLS, TERM_ROWS);
+LcdMenu menu(renderer);
+KeyboardAdapter keyboard(&menu, &Serial);
+
+void setup() {
+    Serial.begin(9600);
+    renderer.begin();
+    menu.setScreen(mainScreen);
+}
+
+void loop() {
+    keyboard.observe();
+    menu.poll();
+}
+
+void inputCallback(char* value) {
+    // Do stuff with value, but don't print it to Serial, it would end up in the menu
+}
@@ -0,0 +1,50 @@
+#include <ItemWidget.h>
+#include <LcdMenu.h>
+#include <MenuScreen.h>
+#include <display/LiquidCrystal_I2CAdapter.h>
+#include <input/KeyboardAdapter.h>
+#include <renderer/CharacterDisplayRenderer.h>
+#include <widget/WidgetBar.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+#define LED_PIN 9
+
+// clang-format off
+MENU_SCREEN(mainScreen, mainItems,
+    // Edit with UP and DOWN, one pixel column per step
+    ITEM_WIDGET(
+        "PWM",
+        [](int duty) { analogWrite(LED_PIN, duty); },
+        WIDGET_BAR(128, 5, 0, 255, 10)),
+    // Read-only, updated from the loop
+    ITEM_WIDGET(
+        "Tank",
+        [](int level) {},
+        WIDGET_BAR(0, 1, 0, 100, 8, "%s|")));
+// clang-format on
+
+LiquidCrystal_I2C lcd(0x27, LCD_COLS, LCD_ROWS);
+CharacterDisplayRenderer renderer(new LiquidCrystal_I2CAdapter(&lcd), LCD_COLS, LCD_ROWS);
+LcdMenu menu(renderer);
+KeyboardAdapter keyboard(&menu, &Serial);
+
+unsigned long lastUpdate = 0;
+
+void setup() {
+    Serial.begin(9600);
+    pinMode(LED_PIN, OUTPUT);
+    renderer.begin();
+    menu.setScreen(mainScreen);
+}
+
+void loop() {
+    keyboard.observe();
+    if (millis() - lastUpdate >= 200) {
+        lastUpdate = millis();
+        int level = map(analogRead(A0), 0, 1023, 0, 100);
+        static_cast<ItemWidget<int>*>(mainItems[1])->setValues(level);
+        // Only the cells of the bar which changed are written
+        menu.refresh();
+    }
+}
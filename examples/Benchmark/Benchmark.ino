@@ -0,0 +1,37 @@
+// Measure the worst-case execution time of LcdMenu::process for every item type.
+// Runs once at startup, on hardware or in a simulator (see docs, "Worst-case execution time"),
+// and prints one line per item type followed by `#BENCH# PASS` or `#BENCH# FAIL`.
+#ifdef __AVR__
+// Leave enough RAM on the Uno for the copies made while typing
+#define BENCHMARK_INPUT_LENGTH 120
+#endif
+
+#include "BenchmarkSuite.h"
+#include <renderer/CharacterDisplayRenderer.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+// Maximum allowed duration of a single command in microseconds
+#define BUDGET 20000
+
+CharacterDisplayRenderer renderer(new BenchmarkDisplay(), LCD_COLS, LCD_ROWS);
+LcdMenu menu(renderer);
+WcetBenchmark<BENCHMARK_ROWS> benchmark(menu);
+
+void setup() {
+    Serial.begin(9600);
+    renderer.begin();
+    benchmark.setBudget(ENTER, BUDGET);
+    benchmark.setBudget(BACK, BUDGET);
+    benchmark.setBudget(UP, BUDGET);
+    benchmark.setBudget(DOWN, BUDGET);
+    benchmark.setBudget(LEFT, BUDGET);
+    benchmark.setBudget(RIGHT, BUDGET);
+    benchmark.setBudget(BACKSPACE, BUDGET);
+    benchmark.setBudget(CLEAR, BUDGET);
+    benchmark.setBudget('a', BUDGET);
+    runBenchmarkSuite(menu, benchmark);
+    benchmark.report(Serial);
+}
+
+void loop() {}
@@ -0,0 +1,153 @@
+// Adversarial menu and input scripts for the worst-case execution time benchmark.
+#pragma once
+
+#include <ItemBack.h>
+#include <ItemCommand.h>
+#include <ItemFloatRange.h>
+#include <ItemInput.h>
+#include <ItemInputCharset.h>
+#include <ItemIntRange.h>
+#include <ItemSubMenu.h>
+#include <ItemToggle.h>
+#include <ItemValue.h>
+#include <ItemWidget.h>
+#include <LcdMenu.h>
+#include <MenuScreen.h>
+#include <display/CharacterDisplayInterface.h>
+#include <utils/benchmark.h>
+#include <widget/WidgetBool.h>
+#include <widget/WidgetList.h>
+#include <widget/WidgetRange.h>
+
+// ItemInput keeps its length in an uint8_t, the script types 4 more characters.
+// Typing in the middle copies the value twice on the stack, lower it on boards with little RAM.
+#ifndef BENCHMARK_INPUT_LENGTH
+#define BENCHMARK_INPUT_LENGTH 250
+#endif
+#define BENCHMARK_DEPTH 8
+#define BENCHMARK_ROWS 14
+
+// Display without a bus, so the benchmark measures the library alone.
+// Replace it with a real adapter to include the time spent talking to the display.
+class BenchmarkDisplay : public CharacterDisplayInterface {
+  public:
+    void begin() override {}
+    void clear() override {}
+    void show() override {}
+    void hide() override {}
+    void draw(uint8_t byte) override {}
+    void draw(const char* text) override {}
+    void setCursor(uint8_t col, uint8_t row) override {}
+    void setBacklight(bool enabled) override {}
+    void createChar(uint8_t id, uint8_t* c) override {}
+    void drawBlinker() override {}
+    void clearBlinker() override {}
+};
+
+// Input values are reallocated when typing, so they must live on the heap
+inline char* benchmarkValue(uint8_t length) {
+    char* value = new char[length + 1];
+    memset(value, 'x', length);
+    value[length] = '\0';
+    return value;
+}
+
+const char* benchmarkOptions[] = {"Zero", "One", "Two", "Three", "Four", "Five", "Six", "Seven"};
+long benchmarkCounter = 2147483647L;
+
+extern MenuScreen* benchmarkLevel1;
+extern MenuScreen* benchmarkLevel2;
+extern MenuScreen* benchmarkLevel3;
+extern MenuScreen* benchmarkLevel4;
+extern MenuScreen* benchmarkLevel5;
+extern MenuScreen* benchmarkLevel6;
+extern MenuScreen* benchmarkLevel7;
+extern MenuScreen* benchmarkLevel8;
+
+// Items are ordered like the rows of the benchmark, see `runBenchmarkSuite`.
+// Texts are longer than any display to stress clipping and view shifting.
+// clang-format off
+MENU_SCREEN(benchmarkScreen, benchmarkItems,
+    ITEM_BASIC("Basic item with a text longer than any display"),
+    ITEM_COMMAND("Command item with a text longer than any display", []() {}),
+    ITEM_TOGGLE("Toggle item with a text longer than any display", [](bool isOn) {}),
+    ITEM_INT_RANGE("Int", -32768, 32767, 32766, [](int value) {}, "%d", 1, true),
+    ITEM_FLOAT_RANGE("Float", -1000.0f, 1000.0f, 999.9f, [](float value) {}, "%.2f", 0.1f, true),
+    ITEM_INPUT("Input", benchmarkValue(BENCHMARK_INPUT_LENGTH), [](char* value) {}),
+    ITEM_INPUT_CHARSET("Charset", benchmarkValue(BENCHMARK_INPUT_LENGTH), "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZxz", [](char* value) {}),
+    ITEM_WIDGET("Range", [](int value) {}, WIDGET_RANGE(32766, 1, -32768, 32767, "%d", 0, true)),
+    ITEM_WIDGET("List", [](const char* value) {}, WIDGET_LIST(benchmarkOptions, 8, 7, "%s", 0, true)),
+    ITEM_WIDGET("Bool", [](bool value) {}, WIDGET_BOOL(true, "Enabled", "Disabled", "%s")),
+    ITEM_WIDGET(
+        "Multi",
+        [](int hours, int minutes, const char* day) {},
+        WIDGET_RANGE(23, 1, 0, 23, "%02d", 0, true),
+        WIDGET_RANGE(59, 1, 0, 59, ":%02d", 0, true),
+        WIDGET_LIST(benchmarkOptions, 8, 7, " %s", 0, true)),
+    ITEM_VALUE("Value", &benchmarkCounter, "%ld", 0),
+    ITEM_SUBMENU("Submenu", benchmarkLevel1),
+    ITEM_SUBMENU("Back", benchmarkLevel1));
+
+MENU_SCREEN(benchmarkLevel1, benchmarkLevel1Items, ITEM_SUBMENU("Level 2", benchmarkLevel2), ITEM_BACK());
+MENU_SCREEN(benchmarkLevel2, benchmarkLevel2Items, ITEM_SUBMENU("Level 3", benchmarkLevel3), ITEM_BACK());
+MENU_SCREEN(benchmarkLevel3, benchmarkLevel3Items, ITEM_SUBMENU("Level 4", benchmarkLevel4), ITEM_BACK());
+MENU_SCREEN(benchmarkLevel4, benchmarkLevel4Items, ITEM_SUBMENU("Level 5", benchmarkLevel5), ITEM_BACK());
+MENU_SCREEN(benchmarkLevel5, benchmarkLevel5Items, ITEM_SUBMENU("Level 6", benchmarkLevel6), ITEM_BACK());
+MENU_SCREEN(benchmarkLevel6, benchmarkLevel6Items, ITEM_SUBMENU("Level 7", benchmarkLevel7), ITEM_BACK());
+MENU_SCREEN(benchmarkLevel7, benchmarkLevel7Items, ITEM_SUBMENU("Level 8", benchmarkLevel8), ITEM_BACK());
+MENU_SCREEN(benchmarkLevel8, benchmarkLevel8Items, ITEM_BASIC("Bottom"), ITEM_BACK());
+// clang-format on
+
+// Every command in and out of edit mode, values are pushed past their bounds to hit wrapping
+const unsigned char benchmarkEdit[] = {
+    UP, DOWN, LEFT, RIGHT, BACKSPACE, CLEAR, 'z',
+    ENTER, UP, UP, UP, DOWN, DOWN, DOWN, DOWN, RIGHT, RIGHT, RIGHT, RIGHT, LEFT, LEFT, LEFT, LEFT,
+    '1', 'z', BACKSPACE, CLEAR, ENTER,
+    ENTER, LEFT, RIGHT, UP, DOWN, BACK};
+
+// Typing into a full value, in the middle and at the end, then clearing it
+const unsigned char benchmarkInput[] = {
+    ENTER, LEFT, LEFT, LEFT, 'z', 'z', RIGHT, RIGHT, RIGHT, 'z', 'z',
+    UP, DOWN, BACKSPACE, BACKSPACE, BACKSPACE, BACKSPACE, LEFT, BACKSPACE,
+    CLEAR, BACKSPACE, LEFT, RIGHT, 'z', ENTER,
+    ENTER, 'z', BACK};
+
+// Down to the deepest screen and back with BACK commands
+const unsigned char benchmarkSubmenu[] = {
+    ENTER, ENTER, ENTER, ENTER, ENTER, ENTER, ENTER, ENTER, ENTER,
+    UP, DOWN, LEFT, RIGHT, 'z', BACKSPACE, CLEAR,
+    BACK, BACK, BACK, BACK, BACK, BACK, BACK, BACK};
+
+// Down to the deepest screen and back with ItemBack items
+const unsigned char benchmarkBack[] = {
+    ENTER, ENTER, ENTER, ENTER, ENTER, ENTER, ENTER, ENTER,
+    DOWN, ENTER, DOWN, ENTER, DOWN, ENTER, DOWN, ENTER, DOWN, ENTER, DOWN, ENTER, DOWN, ENTER, DOWN, ENTER};
+
+/**
+ * Run the scripts on every item of `benchmarkScreen`, the menu should already be set up.
+ */
+inline void runBenchmarkSuite(LcdMenu& menu, WcetBenchmark<BENCHMARK_ROWS>& benchmark) {
+    menu.setScreen(benchmarkScreen);
+    for (uint8_t i = 0; i < BENCHMARK_ROWS; i++) {
+        menu.setCursor(i);
+        switch (i) {
+            case 0: benchmark.run(i, F("ItemBasic"), benchmarkEdit, sizeof(benchmarkEdit)); break;
+            case 1: benchmark.run(i, F("ItemCommand"), benchmarkEdit, sizeof(benchmarkEdit)); break;
+            case 2: benchmark.run(i, F("ItemToggle"), benchmarkEdit, sizeof(benchmarkEdit)); break;
+            case 3: benchmark.run(i, F("ItemIntRange"), benchmarkEdit, sizeof(benchmarkEdit)); break;
+            case 4: benchmark.run(i, F("ItemFloatRange"), benchmarkEdit, sizeof(benchmarkEdit)); break;
+            case 5: benchmark.run(i, F("ItemInput"), benchmarkInput, sizeof(benchmarkInput)); break;
+            case 6: benchmark.run(i, F("ItemInputCharset"), benchmarkInput, sizeof(benchmarkInput)); break;
+            case 7: benchmark.run(i, F("WidgetRange"), benchmarkEdit, sizeof(benchmarkEdit)); break;
+            case 8: benchmark.run(i, F("WidgetList"), benchmarkEdit, sizeof(benchmarkEdit)); break;
+            case 9: benchmark.run(i, F("WidgetBool"), benchmarkEdit, sizeof(benchmarkEdit)); break;
+            case 10: benchmark.run(i, F("ItemWidget"), benchmarkEdit, sizeof(benchmarkEdit)); break;
+            case 11: benchmark.run(i, F("ItemValue"), benchmarkEdit, sizeof(benchmarkEdit)); break;
+            case 12: benchmark.run(i, F("ItemSubMenu"), benchmarkSubmenu, sizeof(benchmarkSubmenu)); break;
+            case 13: benchmark.run(i, F("ItemBack"), benchmarkBack, sizeof(benchmarkBack)); break;
+        }
+        // Leave any screen or edit mode left over by the script
+        menu.setScreen(benchmarkScreen);
+        menu.getRenderer()->setEditMode(false);
+    }
+}
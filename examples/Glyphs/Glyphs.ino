@@ -0,0 +1,53 @@
+#include <LcdMenu.h>
+#include <MenuScreen.h>
+#include <display/LiquidCrystal_I2CAdapter.h>
+#include <input/KeyboardAdapter.h>
+#include <renderer/CharacterDisplayRenderer.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+// Glyphs are 5x8 pixels, one byte per line
+uint8_t bell[8] = {0x04, 0x0E, 0x0E, 0x0E, 0x1F, 0x00, 0x04, 0x00};
+uint8_t heart[8] = {0x00, 0x0A, 0x1F, 0x1F, 0x0E, 0x04, 0x00, 0x00};
+uint8_t lock[8] = {0x0E, 0x11, 0x11, 0x1F, 0x1B, 0x1B, 0x1F, 0x00};
+
+/**
+ * Item showing an icon after its text.
+ * The renderer puts the icon into a free custom character slot while the row is visible.
+ */
+class ItemIcon : public MenuItem {
+  protected:
+    const uint8_t* icon;
+
+  public:
+    ItemIcon(const char* text, const uint8_t* icon) : MenuItem(text), icon(icon) {}
+
+  protected:
+    void draw(MenuRenderer* renderer) override {
+        // Fall back to a plain character if all slots are in use
+        char value[] = {(char)renderer->glyph(icon, '*'), '\0'};
+        renderer->drawItem(text, value);
+    }
+};
+
+// clang-format off
+MENU_SCREEN(mainScreen, mainItems,
+    new ItemIcon("Alarm", bell),
+    new ItemIcon("Favorites", heart),
+    new ItemIcon("Security", lock),
+    new ItemIcon("Snooze", bell));
+// clang-format on
+
+LiquidCrystal_I2C lcd(0x27, LCD_COLS, LCD_ROWS);
+CharacterDisplayRenderer renderer(new LiquidCrystal_I2CAdapter(&lcd), LCD_COLS, LCD_ROWS);
+LcdMenu menu(renderer);
+KeyboardAdapter keyboard(&menu, &Serial);
+
+void setup() {
+    Serial.begin(9600);
+    renderer.begin();
+    menu.setScreen(mainScreen);
+}
+
+void loop() { keyboard.observe(); }
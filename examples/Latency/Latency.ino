@@ -0,0 +1,65 @@
+// Record durations of input handling and drawing into histograms.
+// Defined here it only reaches this sketch and the header-only input adapters,
+// add it to the build flags to instrument the library sources as well, e.g.
+// `build_flags = -D DEBUG_LATENCY` in platformio.ini or
+// `--build-property "compiler.cpp.extra_flags=-DDEBUG_LATENCY"` with arduino-cli.
+#define DEBUG_LATENCY
+
+#include <ItemToggle.h>
+#include <LcdMenu.h>
+#include <MenuScreen.h>
+#include <display/LiquidCrystal_I2CAdapter.h>
+#include <input/KeyboardAdapter.h>
+#include <renderer/CharacterDisplayRenderer.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+#define REPORT_INTERVAL 10000
+
+// clang-format off
+MENU_SCREEN(mainScreen, mainItems,
+    ITEM_BASIC("Start service"),
+    ITEM_BASIC("Connect to WiFi"),
+    ITEM_TOGGLE("Backlight", [](bool isOn) { /* ... */ }),
+    ITEM_BASIC("Blink SOS"),
+    ITEM_BASIC("Blink random"));
+// clang-format on
+
+LiquidCrystal_I2C lcd(0x27, LCD_COLS, LCD_ROWS);
+CharacterDisplayRenderer renderer(new LiquidCrystal_I2CAdapter(&lcd), LCD_COLS, LCD_ROWS);
+LcdMenu menu(renderer);
+KeyboardAdapter keyboard(&menu, &Serial);
+
+unsigned long lastReport = 0;
+
+void setup() {
+    Serial.begin(9600);
+    renderer.begin();
+    menu.setScreen(mainScreen);
+}
+
+/**
+ * Without the build flag the library records nothing, measure the keypress to display latency here.
+ */
+bool libraryInstrumented() {
+    return latencyHistogram(LATENCY_PROCESS).getCount() > 0;
+}
+
+void loop() {
+    bool pending = keyboard.hasPendingInput();
+    unsigned long start = micros();
+    keyboard.observe();
+    // The display is written synchronously, it shows the result when `observe` returns
+    if (pending && !libraryInstrumented()) {
+        latencyHistogram(LATENCY_INPUT_TO_GLASS).record(micros() - start);
+    }
+    if (millis() - lastReport >= REPORT_INTERVAL) {
+        lastReport = millis();
+        // Worst case keypress to display latency is in the `inputToGlass` line
+        latencyPrint(Serial);
+        if (latencyHistogram(LATENCY_OBSERVE).getCount() > 0 && !libraryInstrumented()) {
+            Serial.println(F("Library built without DEBUG_LATENCY, only observe and inputToGlass are measured"));
+        }
+        latencyReset();
+    }
+}
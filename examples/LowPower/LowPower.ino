@@ -0,0 +1,66 @@
+#include <Button.h>
+#include <LcdMenu.h>
+#include <MenuScreen.h>
+#include <avr/sleep.h>
+#include <display/LiquidCrystal_I2CAdapter.h>
+#include <input/ButtonAdapter.h>
+#include <renderer/CharacterDisplayRenderer.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+// clang-format off
+MENU_SCREEN(mainScreen, mainItems,
+    ITEM_BASIC("Start service"),
+    ITEM_BASIC("Connect to WiFi"),
+    ITEM_BASIC("Settings"),
+    ITEM_BASIC("Blink SOS"),
+    ITEM_BASIC("Blink random"));
+// clang-format on
+
+LiquidCrystal_I2C lcd(0x27, LCD_COLS, LCD_ROWS);
+LiquidCrystal_I2CAdapter lcdAdapter(&lcd);
+CharacterDisplayRenderer renderer(&lcdAdapter, LCD_COLS, LCD_ROWS);
+LcdMenu menu(renderer);
+// Pins 2 and 3 have external interrupts on an Uno
+Button downBtn(2);
+ButtonAdapter downBtnA(&menu, &downBtn, DOWN);
+Button enterBtn(3);
+ButtonAdapter enterBtnA(&menu, &enterBtn, ENTER);
+const uint8_t downPins[] = {2};
+const uint8_t enterPins[] = {3};
+
+volatile bool woken = false;
+
+void wake() { woken = true; }
+
+void setup() {
+    downBtn.begin();
+    enterBtn.begin();
+    downBtnA.setWakePins(downPins, 1);
+    enterBtnA.setWakePins(enterPins, 1);
+    menu.getWakePins([](uint8_t pin) { attachInterrupt(digitalPinToInterrupt(pin), wake, CHANGE); });
+    renderer.begin();
+    renderer.setTimeout(DISPLAY_TIMEOUT);
+    menu.setScreen(mainScreen);
+}
+
+void loop() {
+    downBtnA.observe();
+    enterBtnA.observe();
+    menu.poll();
+
+    MenuIdleState state;
+    if (!menu.getIdleState(state)) {
+        return;
+    }
+    // Sleep until the next deadline of the menu or a button is pressed,
+    // the idle mode keeps millis() running and stops the CPU in between
+    unsigned long start = millis();
+    unsigned long time = state.getSleepTime(start);
+    woken = false;
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    while (!woken && millis() - start < time) {
+        sleep_mode();
+    }
+}
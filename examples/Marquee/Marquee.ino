@@ -0,0 +1,36 @@
+#include <ItemInput.h>
+#include <LcdMenu.h>
+#include <MenuScreen.h>
+#include <display/LiquidCrystal_I2CAdapter.h>
+#include <input/KeyboardAdapter.h>
+#include <renderer/CharacterDisplayRenderer.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+// clang-format off
+MENU_SCREEN(mainScreen, mainItems,
+    ITEM_BASIC("Connect to the strongest access point"),
+    ITEM_BASIC("Short"),
+    ITEM_INPUT("Name of this device", [](char* value) { Serial.println(value); }),
+    ITEM_BASIC("Restore the factory settings"));
+// clang-format on
+
+LiquidCrystal_I2C lcd(0x27, LCD_COLS, LCD_ROWS);
+CharacterDisplayRenderer renderer(new LiquidCrystal_I2CAdapter(&lcd), LCD_COLS, LCD_ROWS);
+LcdMenu menu(renderer);
+KeyboardAdapter keyboard(&menu, &Serial);
+
+void setup() {
+    Serial.begin(9600);
+    renderer.begin();
+    // One column every 300 ms, wait 1.5 s at both ends
+    renderer.setMarquee(300, 1500);
+    menu.setScreen(mainScreen);
+}
+
+void loop() {
+    keyboard.observe();
+    // Scrolls the focused row, not in edit mode
+    menu.poll();
+}
@@ -0,0 +1,96 @@
+#include <ItemSubMenu.h>
+#include <ItemToggle.h>
+#include <LcdMenu.h>
+#include <MenuIndex.h>
+#include <MenuScreen.h>
+#include <display/LiquidCrystal_I2CAdapter.h>
+#include <renderer/CharacterDisplayRenderer.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+extern MenuScreen* settingsScreen;
+extern MenuScreen* networkScreen;
+
+// clang-format off
+MENU_SCREEN(mainScreen, mainItems,
+    ITEM_BASIC("Start service"),
+    ITEM_SUBMENU("Settings", settingsScreen),
+    ITEM_BASIC("About"));
+
+MENU_SCREEN(settingsScreen, settingsItems,
+    ITEM_SUBMENU("Network", networkScreen),
+    ITEM_TOGGLE("Backlight", [](bool enabled) {}));
+
+MENU_SCREEN(networkScreen, networkItems,
+    ITEM_TOGGLE("DHCP", [](bool enabled) {}),
+    ITEM_BASIC("Address"));
+// clang-format on
+
+LiquidCrystal_I2C lcd(0x27, LCD_COLS, LCD_ROWS);
+CharacterDisplayRenderer renderer(new LiquidCrystal_I2CAdapter(&lcd), LCD_COLS, LCD_ROWS);
+LcdMenu menu(renderer);
+MenuIndex menuIndex;
+
+char path[32];
+uint8_t pathLength = 0;
+
+/**
+ * IDs don't depend on the position of the items, e.g. to store settings under them.
+ */
+const char* describe(uint16_t id) {
+    switch (id) {
+        case MENU_ID("Settings/Network/DHCP"):
+            return "network setting";
+        case MENU_ID("Settings/Backlight"):
+            return "display setting";
+        default:
+            return "item";
+    }
+}
+
+/**
+ * Show the screen of the item at the path, e.g. "Settings/Network/DHCP".
+ */
+void jump(const char* path) {
+    const MenuIndex::Entry* entry = menuIndex.find(path);
+    if (entry == NULL) {
+        Serial.println(F("No such item"));
+        return;
+    }
+    Serial.print(describe(entry->id));
+    Serial.print(F(", ID "));
+    Serial.println(entry->id);
+    // Link the screens on the way, so BACK leads up the path
+    const MenuIndex::Entry* child = entry;
+    for (const MenuIndex::Entry* parent = menuIndex.getParent(child); parent != NULL;
+         child = parent, parent = menuIndex.getParent(parent)) {
+        child->screen->setParent(parent->screen);
+    }
+    menu.setScreen(entry->screen);
+}
+
+void setup() {
+    Serial.begin(9600);
+    renderer.begin();
+    menu.setScreen(mainScreen);
+    // Walks the screens once, lookups are binary searches afterwards
+    menuIndex.build(mainScreen);
+    Serial.print(menuIndex.getCount());
+    Serial.println(F(" items indexed, send a path to show it"));
+}
+
+void loop() {
+    while (Serial.available() > 0) {
+        char c = Serial.read();
+        if (c == '\n' || c == '\r') {
+            path[pathLength] = '\0';
+            if (pathLength > 0) {
+                jump(path);
+            }
+            pathLength = 0;
+        } else if (pathLength < sizeof(path) - 1) {
+            path[pathLength++] = c;
+        }
+    }
+}
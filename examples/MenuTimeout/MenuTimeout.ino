@@ -27,14 +27,15 @@ KeyboardAdapter keyboard(&menu, &Serial);
 void setup() {
     Serial.begin(9600);
     renderer.begin();
+    // Hide the display after DISPLAY_TIMEOUT ms (10000 by default) without input
+    renderer.setTimeout(DISPLAY_TIMEOUT);
     menu.setScreen(mainScreen);
 }
 
 void loop() {
     /**
      * IMPORTANT: You must call this function for the timeout to work
-     * The default timeout is 10000ms
      */
-    renderer.updateTimer();
+    menu.poll();
     keyboard.observe();
 }
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include <ItemInput.h>
+#include <ItemWidget.h>
+#include <LcdMenu.h>
+#include <MenuScreen.h>
+#include <display/LiquidCrystal_I2CAdapter.h>
+#include <input/KeyboardAdapter.h>
+#include <renderer/AnsiRenderer.h>
+#include <renderer/CharacterDisplayRenderer.h>
+#include <renderer/MirrorRenderer.h>
+#include <widget/WidgetBar.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+void inputCallback(char* value);
+
+// clang-format off
+MENU_SCREEN(mainScreen, mainItems,
+    ITEM_BASIC("Start service"),
+    ITEM_INPUT("Name", inputCallback),
+    ITEM_WIDGET("Level", [](int level) {}, WIDGET_BAR(10, 1, 0, 40, 8)),
+    ITEM_BASIC("Connect to WiFi"),
+    ITEM_BASIC("Blink SOS"),
+    ITEM_BASIC("Blink random"));
+// clang-format on
+
+// Front panel
+LiquidCrystal_I2C lcd(0x27, LCD_COLS, LCD_ROWS);
+LiquidCrystal_I2CAdapter lcdAdapter(&lcd);
+CharacterDisplayRenderer lcdRenderer(&lcdAdapter, LCD_COLS, LCD_ROWS);
+// Service port, open it in a terminal emulator
+AnsiRenderer terminalRenderer(&Serial, 40, LCD_ROWS);
+// The menu draws into the mirror, which shows it on both
+MirrorRenderer renderer(LCD_ROWS);
+LcdMenu menu(renderer);
+KeyboardAdapter keyboard(&menu, &Serial);
+
+void setup() {
+    Serial.begin(9600);
+    renderer.addTarget(&lcdRenderer);
+    // The terminal gets at most 5 frames per second, the LCD every frame
+    renderer.addTarget(&terminalRenderer, 200);
+    renderer.begin();
+    menu.setScreen(mainScreen);
+}
+
+void loop() {
+    keyboard.observe();
+    menu.poll();
+}
+
+void inputCallback(char* value) {
+    // Do stuff with value
+}
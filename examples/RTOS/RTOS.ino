@@ -4,11 +4,14 @@
 #endif
 #include <ItemSubMenu.h>
 #include <ItemToggle.h>
+#include <ItemValue.h>
 #include <LcdMenu.h>
 #include <MenuScreen.h>
 #include <display/LiquidCrystal_I2CAdapter.h>
 #include <input/KeyboardAdapter.h>
 #include <renderer/CharacterDisplayRenderer.h>
+#include <utils/FreeRTOSLock.h>
+#include <utils/UpdateQueue.h>
 #include <utils/printf.h>
 
 // 2x20 LCD Display
@@ -41,6 +44,8 @@ LiquidCrystal_I2CAdapter lcdAdapter(&lcd);
 CharacterDisplayRenderer renderer(&lcdAdapter, LCD_COLS, LCD_ROWS);
 LcdMenu menu(renderer);
 KeyboardAdapter keyboard(&menu, &Serial);
+// Values posted by the measuring task, applied and drawn by the loop only
+UpdateQueue<FreeRTOSLock, 2> updates;
 
 extern MenuScreen* relayScreen;
 extern MenuScreen* tempScreen;
@@ -63,9 +68,11 @@ MENU_SCREEN(relayScreen, relayItems,
 
 // Sub Menu 2: Temperature Values
 // clang-format off
+BaseItemValue* currentItem = ITEM_VALUE("I");
+BaseItemValue* voltageItem = ITEM_VALUE("U");
 MENU_SCREEN(tempScreen, tempItems, 
-    ITEM_BASIC(""), 
-    ITEM_BASIC(""));
+    currentItem, 
+    voltageItem);
 // clang-format on
 
 // RTOS func. to measure temperature value
@@ -77,19 +84,9 @@ static void tempMeas(void* pvParameters) {
         temperature2 = random(1, 2000) / 100.0;  // Generate random float
         //-------------------END: TEST WITH RANDOM--------------------//
 
-        char buffer1[8];
-        snprintf(buffer1, sizeof(buffer1), "%.02f mA", temperature1);
-        tempItems[0]->setText(buffer1);
-
-        vTaskDelay(500 / portTICK_PERIOD_MS);  // wait for 200ms
-
-        char buffer2[8];
-        snprintf(buffer2, sizeof(buffer2), "%.02f V", temperature2);
-        tempItems[1]->setText(buffer2);
-
-        if (menu.getScreen() == tempScreen) {
-            menu.refresh();
-        }
+        // Never draw from this task, the loop redraws the changed rows in menu.poll()
+        updates.post(currentItem, "%.02f mA", temperature1);
+        updates.post(voltageItem, "%.02f V", temperature2);
         vTaskDelay(3000 / portTICK_PERIOD_MS);  // wait for three seconds
     }
 }
@@ -99,8 +96,10 @@ void setup() {
     // LCD activation
     renderer.begin();
     menu.setScreen(mainScreen);
+    menu.setUpdateQueue(&updates);
     // Run RTOS func.
-    xTaskCreate(tempMeas, "tempMeas", 128, NULL, tskIDLE_PRIORITY + 1, NULL);
+    // Formatting the values needs some more stack than the minimal one
+    xTaskCreate(tempMeas, "tempMeas", 256, NULL, tskIDLE_PRIORITY + 1, NULL);
     // Setup random seed
     pinMode(A0, INPUT);
     randomSeed(analogRead(A0));
@@ -109,4 +108,5 @@ void setup() {
 void loop() {
     renderer.updateTimer();
     keyboard.observe();
+    menu.poll();
 }
@@ -0,0 +1,52 @@
+#include <ItemInput.h>
+#include <ItemWidget.h>
+#include <LcdMenu.h>
+#include <MenuScreen.h>
+#include <display/LiquidCrystal_I2CAdapter.h>
+#include <input/RemoteAdapter.h>
+#include <renderer/CharacterDisplayRenderer.h>
+#include <renderer/MirrorRenderer.h>
+#include <renderer/RemoteRenderer.h>
+#include <widget/WidgetBar.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+void inputCallback(char* value);
+
+// clang-format off
+MENU_SCREEN(mainScreen, mainItems,
+    ITEM_BASIC("Start service"),
+    ITEM_INPUT("Name", inputCallback),
+    ITEM_WIDGET("Level", [](int level) {}, WIDGET_BAR(10, 1, 0, 40, 8)),
+    ITEM_BASIC("Connect to WiFi"),
+    ITEM_BASIC("Blink SOS"));
+// clang-format on
+
+// Front panel
+LiquidCrystal_I2C lcd(0x27, LCD_COLS, LCD_ROWS);
+LiquidCrystal_I2CAdapter lcdAdapter(&lcd);
+CharacterDisplayRenderer lcdRenderer(&lcdAdapter, LCD_COLS, LCD_ROWS);
+// Remote on the serial port, it sends the rows which changed to a subscribed PC
+RemoteRenderer remoteRenderer(&Serial, LCD_COLS, LCD_ROWS);
+MirrorRenderer renderer(LCD_ROWS);
+LcdMenu menu(renderer);
+// Commands of the PC are processed like keys
+RemoteAdapter remote(&menu, &Serial, &remoteRenderer);
+
+void setup() {
+    Serial.begin(115200);
+    renderer.addTarget(&lcdRenderer);
+    renderer.addTarget(&remoteRenderer);
+    renderer.begin();
+    menu.setScreen(mainScreen);
+}
+
+void loop() {
+    remote.observe();
+    menu.poll();
+}
+
+void inputCallback(char* value) {
+    // Do stuff with value
+}
@@ -0,0 +1,56 @@
+#if defined(ARDUINO_ARCH_AVR)
+#include <Arduino_FreeRTOS.h>
+#endif
+#include <LcdMenu.h>
+#include <MenuScreen.h>
+#include <display/FrameBufferDisplay.h>
+#include <display/LiquidCrystal_I2CAdapter.h>
+#include <input/KeyboardAdapter.h>
+#include <renderer/CharacterDisplayRenderer.h>
+#include <utils/FreeRTOSLock.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+// clang-format off
+MENU_SCREEN(mainScreen, mainItems,
+    ITEM_BASIC("Start service"),
+    ITEM_BASIC("Connect to WiFi"),
+    ITEM_BASIC("Settings"),
+    ITEM_BASIC("Blink SOS"),
+    ITEM_BASIC("Blink random"));
+// clang-format on
+
+LiquidCrystal_I2C lcd(0x27, LCD_COLS, LCD_ROWS);
+LiquidCrystal_I2CAdapter lcdAdapter(&lcd);
+// The menu draws into memory, only the render task talks to the LCD
+FrameBufferDisplay<FreeRTOSLock> frameBuffer(&lcdAdapter, LCD_COLS, LCD_ROWS);
+CharacterDisplayRenderer renderer(&frameBuffer, LCD_COLS, LCD_ROWS);
+LcdMenu menu(renderer);
+KeyboardAdapter keyboard(&menu, &Serial);
+
+// Writes the changed cells of the latest frame to the LCD
+static void renderTask(void* pvParameters) {
+    (void)pvParameters;
+    for (;;) {
+        frameBuffer.flush();
+        vTaskDelay(20 / portTICK_PERIOD_MS);
+    }
+}
+
+void setup() {
+    Serial.begin(9600);
+    renderer.begin();
+    menu.setScreen(mainScreen);
+#if defined(ARDUINO_ARCH_ESP32)
+    // Loop runs on core 1, keep the slow I2C writes on the other core
+    xTaskCreatePinnedToCore(renderTask, "render", 2048, NULL, tskIDLE_PRIORITY + 1, NULL, 0);
+#else
+    xTaskCreate(renderTask, "render", 128, NULL, tskIDLE_PRIORITY + 1, NULL);
+#endif
+}
+
+void loop() {
+    renderer.updateTimer();
+    keyboard.observe();
+}
@@ -0,0 +1,68 @@
+#include <ItemCommand.h>
+#include <LcdMenu.h>
+#include <MenuScreen.h>
+#include <display/LiquidCrystal_I2CAdapter.h>
+#include <input/InputRecorder.h>
+#include <input/InputReplay.h>
+#include <input/KeyboardAdapter.h>
+#include <renderer/CharacterDisplayRenderer.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+void printRecording();
+
+// clang-format off
+MENU_SCREEN(mainScreen, mainItems,
+    ITEM_BASIC("Start service"),
+    ITEM_BASIC("Connect to WiFi"),
+    ITEM_BASIC("Settings"),
+    ITEM_BASIC("Blink SOS"),
+    ITEM_COMMAND("Print recording", printRecording));
+// clang-format on
+
+LiquidCrystal_I2C lcd(0x27, LCD_COLS, LCD_ROWS);
+LiquidCrystal_I2CAdapter lcdAdapter(&lcd);
+CharacterDisplayRenderer renderer(&lcdAdapter, LCD_COLS, LCD_ROWS);
+LcdMenu menu(renderer);
+KeyboardAdapter keyboard(&menu, &Serial);
+
+// Demo played at startup: down, down, up, each half a second apart
+uint8_t demo[] = {0xF4, 0x03, DOWN, 0xF4, 0x03, DOWN, 0xF4, 0x03, UP};
+RecordBuffer demoRecording(demo, sizeof(demo), sizeof(demo));
+InputReplay replay(&menu, &demoRecording);
+
+// Everything typed on the serial monitor afterwards
+uint8_t storage[128];
+RecordBuffer recording(storage, sizeof(storage));
+InputRecorder recorder(&menu, &keyboard, &recording);
+
+void setup() {
+    Serial.begin(9600);
+    renderer.begin();
+    menu.setScreen(mainScreen);
+    recorder.stop();
+    replay.start();
+}
+
+void loop() {
+    if (replay.isPlaying() && replay.isDone()) {
+        replay.stop();
+        recorder.start();
+    }
+    replay.observe();
+    recorder.observe();
+    menu.poll();
+}
+
+/**
+ * Print the recording as an array, to replay it in a host test or run it with `WcetBenchmark`
+ */
+void printRecording() {
+    Serial.print(F("uint8_t recording[] = {"));
+    for (size_t i = 0; i < recording.getLength(); i++) {
+        Serial.print(i > 0 ? F(", ") : F(""));
+        Serial.print(recording.getData()[i]);
+    }
+    Serial.println(F("};"));
+}
@@ -0,0 +1,63 @@
+#include <ItemInput.h>
+#include <ItemValue.h>
+#include <LcdMenu.h>
+#include <MenuScreen.h>
+#include <display/LiquidCrystal_I2CAdapter.h>
+#include <display/PanelShadow.h>
+#include <input/KeyboardAdapter.h>
+#include <renderer/CharacterDisplayRenderer.h>
+
+#define LCD_ROWS 4
+#define LCD_COLS 20
+
+unsigned long uptime = 0;
+int temperature = 21;
+
+void inputCallback(char* value);
+
+// clang-format off
+MENU_SCREEN(statusScreen, statusItems,
+    ITEM_VALUE("Uptime", &uptime, "%lu s"),
+    ITEM_VALUE("Temp", &temperature, "%d C"));
+
+MENU_SCREEN(mainScreen, mainItems,
+    ITEM_BASIC("Start service"),
+    ITEM_INPUT("Name", inputCallback),
+    ITEM_BASIC("Connect to WiFi"),
+    ITEM_BASIC("Blink SOS"),
+    ITEM_BASIC("Blink random"));
+// clang-format on
+
+LiquidCrystal_I2C lcd(0x27, LCD_COLS, LCD_ROWS);
+LiquidCrystal_I2CAdapter lcdAdapter(&lcd);
+// Both renderers write to the display, the shared shadow knows all of its cells
+PanelShadow panel(LCD_COLS, LCD_ROWS);
+// Status on the first 2 rows, without cursor and arrows
+CharacterDisplayRenderer statusRenderer(&lcdAdapter, LCD_COLS, 2, 0, 0, NULL, NULL);
+LcdMenu status(statusRenderer);
+// Menu on the last 2 rows
+CharacterDisplayRenderer menuRenderer(&lcdAdapter, LCD_COLS, 2);
+LcdMenu menu(menuRenderer);
+KeyboardAdapter keyboard(&menu, &Serial);
+
+void setup() {
+    Serial.begin(9600);
+    statusRenderer.setViewport(0, 0, LCD_COLS, 2, &panel);
+    menuRenderer.setViewport(0, 2, LCD_COLS, 2, &panel);
+    statusRenderer.begin();
+    menuRenderer.begin();
+    status.setScreen(statusScreen);
+    menu.setScreen(mainScreen);
+}
+
+void loop() {
+    uptime = millis() / 1000;
+    keyboard.observe();
+    // Values of the status are drawn when they change, the menu keeps its rows
+    status.poll();
+    menu.poll();
+}
+
+void inputCallback(char* value) {
+    // Do stuff with value
+}
@@ -0,0 +1,41 @@
+// Record LOG calls as binary events instead of printing them,
+// define it in the build flags to trace the library sources as well.
+#define DEBUG_TRACE
+
+#include <ItemWidget.h>
+#include <LcdMenu.h>
+#include <MenuScreen.h>
+#include <display/LiquidCrystal_I2CAdapter.h>
+#include <input/KeyboardAdapter.h>
+#include <renderer/CharacterDisplayRenderer.h>
+#include <widget/WidgetRange.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+// clang-format off
+MENU_SCREEN(mainScreen, mainItems,
+    ITEM_BASIC("Start service"),
+    ITEM_WIDGET(
+        "Speed",
+        [](const int speed) { LOG(F("speed"), speed); },
+        WIDGET_RANGE(10, 5, 0, 100, "%d", 0, false)),
+    ITEM_BASIC("Settings"));
+// clang-format on
+
+LiquidCrystal_I2C lcd(0x27, LCD_COLS, LCD_ROWS);
+CharacterDisplayRenderer renderer(new LiquidCrystal_I2CAdapter(&lcd), LCD_COLS, LCD_ROWS);
+LcdMenu menu(renderer);
+KeyboardAdapter keyboard(&menu, &Serial);
+
+void setup() {
+    Serial.begin(115200);
+    renderer.begin();
+    menu.setScreen(mainScreen);
+}
+
+void loop() {
+    keyboard.observe();
+    // Send recorded events while there is room in the serial buffer, never waits
+    traceFlush();
+}
@@ -0,0 +1,44 @@
+#include <ItemTrend.h>
+#include <LcdMenu.h>
+#include <MenuScreen.h>
+#include <display/LiquidCrystal_I2CAdapter.h>
+#include <input/KeyboardAdapter.h>
+#include <renderer/CharacterDisplayRenderer.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+#define SAMPLE_INTERVAL 500
+
+// clang-format off
+MENU_SCREEN(mainScreen, mainItems,
+    // Last 20 readings, 4 characters wide
+    ITEM_TREND<20>("Light", 0, 1023),
+    ITEM_TREND<15>("Noise", 0, 1023),
+    ITEM_BASIC("Settings"));
+// clang-format on
+
+LiquidCrystal_I2C lcd(0x27, LCD_COLS, LCD_ROWS);
+CharacterDisplayRenderer renderer(new LiquidCrystal_I2CAdapter(&lcd), LCD_COLS, LCD_ROWS);
+LcdMenu menu(renderer);
+KeyboardAdapter keyboard(&menu, &Serial);
+
+ItemTrend<20>* light = static_cast<ItemTrend<20>*>(mainItems[0]);
+ItemTrend<15>* noise = static_cast<ItemTrend<15>*>(mainItems[1]);
+unsigned long lastSample = 0;
+
+void setup() {
+    Serial.begin(9600);
+    renderer.begin();
+    menu.setScreen(mainScreen);
+}
+
+void loop() {
+    keyboard.observe();
+    if (millis() - lastSample >= SAMPLE_INTERVAL) {
+        lastSample = millis();
+        light->addSample(analogRead(A0));
+        noise->addSample(analogRead(A1));
+    }
+    // Redraws the charts which got new samples
+    menu.poll();
+}
@@ -61,7 +61,7 @@ class BaseItemManyWidgets : public MenuItem {
         uint8_t cursorCol = 0;
 
         for (uint8_t i = 0; i < size; i++) {
-            index += widgets[i]->draw(buf, index);
+            index += widgets[i]->render(renderer, buf, index);
             if (i == activeWidget && renderer->isInEditMode()) {
                 // Calculate the available space for the widgets after the text
                 size_t v_size = renderer->getEffectiveCols() - strlen(text) - 1;
@@ -104,7 +104,7 @@ class ItemInputCharset : public ItemInput {
     void initCharEdit() {
         charEdit = true;
         if (cursor < strlen(value)) {
-            char* e = strchr(charset, value[cursor]);
+            const char* e = strchr(charset, value[cursor]);
             if (e != NULL) {
                 charsetPosition = (int)(e - charset);
                 return;
@@ -22,6 +22,10 @@ class ItemSubMenu : public BaseItemZeroWidget {
      */
     ItemSubMenu(const char* text, MenuScreen*& screen) : BaseItemZeroWidget(text), screen(screen) {}
 
+    MenuScreen* getSubScreen() override {
+        return screen;
+    }
+
   protected:
     void handleCommit(LcdMenu* menu) override {
         LOG(F("ItemSubMenu::changeScreen"), text);
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "MenuItem.h"
+
+/**
+ * @brief Read-only item showing the recent history of a value as a small chart.
+ *
+ * Samples are kept in a ring buffer, the oldest one is replaced by each new
+ * sample. Every sample is one pixel column of 8 pixels, 5 samples per cell,
+ * the newest sample on the right. Each cell is a custom glyph, only glyphs
+ * whose columns changed are uploaded again.
+ *
+ * ```
+ * ┌────────────────────────────┐
+ * │ > T E M P : ▁ ▂ ▄ ▆        │
+ * └────────────────────────────┘
+ * ```
+ *
+ * @tparam Samples number of samples in the history, at most 40
+ * @note Every cell of the chart needs a custom character slot, there are 6 free slots on a character display.
+ *       Cells without a slot are drawn with plain characters.
+ */
+template <uint8_t Samples>
+class ItemTrend : public MenuItem {
+    static_assert(Samples > 0 && Samples <= 40, "ItemTrend has at most 8 cells of 5 samples");
+
+  protected:
+    static const uint8_t Cells = (Samples + 4) / 5;
+    const float minValue;
+    const float maxValue;
+    /**
+     * @brief Height of each sample in pixels, 0 to 8.
+     */
+    uint8_t levels[Samples] = {};
+    /**
+     * @brief Position of the oldest sample.
+     */
+    uint8_t head = 0;
+    /**
+     * @brief Bitmaps of the cells as last drawn.
+     */
+    uint8_t glyphs[Cells][8] = {};
+    /**
+     * @brief Whether a sample was added since the item was last drawn.
+     */
+    bool changed = false;
+
+  public:
+    /**
+     * @param text text of the item
+     * @param min value shown as an empty column
+     * @param max value shown as a full column
+     */
+    ItemTrend(const char* text, float min, float max) : MenuItem(text), minValue(min), maxValue(max) {}
+    /**
+     * @brief Add a sample, it replaces the oldest one.
+     * Must be called from the task owning the menu, the row is redrawn on the next `LcdMenu::poll`.
+     * @param value the sample, values out of the range are shown as empty or full columns,
+     *        all samples are empty columns when the range is empty
+     */
+    void addSample(float value) {
+        float level = maxValue != minValue ? (value - minValue) * 8 / (maxValue - minValue) + 0.5f : 0;
+        levels[head] = level < 0 ? 0 : (level > 8 ? 8 : (uint8_t)level);
+        head = head + 1 < Samples ? head + 1 : 0;
+        changed = true;
+    }
+    /**
+     * @brief Get the height of a sample in pixels, 0 is the oldest sample.
+     */
+    uint8_t getLevel(uint8_t index) const {
+        uint8_t position = head + index;
+        return levels[position < Samples ? position : position - Samples];
+    }
+
+  protected:
+    /**
+     * @brief Fill a bitmap with the 5 columns of a cell.
+     * @return the highest column of the cell
+     */
+    uint8_t drawCell(uint8_t cell, uint8_t* bitmap) const {
+        uint8_t highest = 0;
+        memset(bitmap, 0, 8);
+        for (uint8_t column = 0; column < 5; column++) {
+            // Missing columns of the last cell are left empty
+            uint8_t index = cell * 5 + column;
+            uint8_t level = index < Samples ? getLevel(index) : 0;
+            highest = level > highest ? level : highest;
+            for (uint8_t line = 8 - level; line < 8; line++) {
+                bitSet(bitmap[line], 4 - column);
+            }
+        }
+        return highest;
+    }
+
+    bool poll(unsigned long now) override {
+        return changed;
+    }
+
+    void draw(MenuRenderer* renderer) override {
+        changed = false;
+        char chart[Cells + 1];
+        for (uint8_t cell = 0; cell < Cells; cell++) {
+            uint8_t bitmap[8];
+            uint8_t highest = drawCell(cell, bitmap);
+            bool regenerated = memcmp(bitmap, glyphs[cell], 8) != 0;
+            if (regenerated) {
+                memcpy(glyphs[cell], bitmap, 8);
+            }
+            if (highest == 0) {
+                // Empty cells don't need a slot
+                chart[cell] = ' ';
+                continue;
+            }
+            chart[cell] = renderer->glyph(glyphs[cell], highest <= 4 ? '_' : WIDGET_BAR_FULL, regenerated);
+        }
+        chart[Cells] = '\0';
+        renderer->drawItem(text, chart);
+    }
+};
+
+/**
+ * @brief Create a new item showing the recent history of a value, add samples with `ItemTrend::addSample`.
+ *
+ * @tparam Samples number of samples in the history, 5 per character
+ * @param text The text to display for the item.
+ * @param min The value shown as an empty column.
+ * @param max The value shown as a full column.
+ * @return MenuItem* The created item. Caller takes ownership of the returned pointer.
+ *
+ * @example
+ *   auto item = ITEM_TREND<20>("Temp", 0, 50);
+ */
+template <uint8_t Samples>
+inline MenuItem* ITEM_TREND(const char* text, float min, float max) {
+    return new ItemTrend<Samples>(text, min, max);
+}
@@ -0,0 +1,188 @@
+#pragma once
+
+#include "MenuItem.h"
+#ifndef ARDUINO_ARCH_ESP32
+#ifndef ARDUINO_ARCH_ESP8266
+#include "utils/printf.h"
+#endif
+#endif
+
+/**
+ * @brief Read-only item showing a live value next to its text.
+ *
+ * The value is kept in a buffer owned by the item, so no caller buffer has
+ * to outlive the item. The value can be set with `setValue` from the UI task,
+ * or posted from other tasks through an `UpdateQueue`.
+ * `LcdMenu::poll` only redraws the row if the value changed.
+ *
+ * ```
+ * ┌────────────────────────────┐
+ * │ > T E X T : V A L U E      │
+ * └────────────────────────────┘
+ * ```
+ */
+class BaseItemValue : public MenuItem {
+  protected:
+    /**
+     * @brief Last value, used for drawing and change detection.
+     */
+    char buffer[ITEM_VALUE_BUFFER_SIZE] = "";
+    /**
+     * @brief Whether the value changed since the item was last drawn.
+     */
+    bool changed = false;
+
+  public:
+    explicit BaseItemValue(const char* text) : MenuItem(text) {}
+    /**
+     * @brief Get the current value.
+     */
+    const char* getValue() const {
+        return buffer;
+    }
+    /**
+     * @brief Set the value, it is copied into the item.
+     * Must be called from the task owning the menu, use `UpdateQueue` from other tasks.
+     * @note The row is redrawn on the next `LcdMenu::poll`.
+     * @return true if the value differs from the previous one
+     */
+    bool setValue(const char* value) {
+        if (strncmp(value, buffer, ITEM_VALUE_BUFFER_SIZE - 1) == 0) {
+            return false;
+        }
+        strncpy(buffer, value, ITEM_VALUE_BUFFER_SIZE - 1);
+        buffer[ITEM_VALUE_BUFFER_SIZE - 1] = '\0';
+        changed = true;
+        return true;
+    }
+
+  protected:
+    bool poll(unsigned long now) override {
+        return changed;
+    }
+
+    void draw(MenuRenderer* renderer) override {
+        changed = false;
+        renderer->drawItem(text, buffer);
+    }
+};
+
+/**
+ * @brief Read-only item showing a live value bound to a variable or a getter.
+ *
+ * `LcdMenu::poll` re-samples the value at the item's interval and only
+ * redraws the row if the formatted text changed.
+ *
+ * @tparam T type of the bound value
+ */
+template <typename T>
+class ItemValue : public BaseItemValue {
+  protected:
+    const T* value = nullptr;
+    T (*getter)() = nullptr;
+    const char* format;
+    /**
+     * @brief Minimum time in milliseconds between two samples.
+     */
+    uint16_t interval;
+    uint32_t lastSample = 0;
+
+  public:
+    /**
+     * @brief Construct an item bound to a variable.
+     * @param text text of the item
+     * @param value pointer to the variable, read on every sample
+     * @param format format of the value, e.g. `"%.02f mA"`
+     * @param interval minimum time in milliseconds between two samples
+     */
+    ItemValue(const char* text, const T* value, const char* format, uint16_t interval)
+        : BaseItemValue(text), value(value), format(format), interval(interval) {}
+    /**
+     * @brief Construct an item bound to a getter.
+     * @param text text of the item
+     * @param getter function returning the current value, called on every sample
+     * @param format format of the value, e.g. `"%d rpm"`
+     * @param interval minimum time in milliseconds between two samples
+     */
+    ItemValue(const char* text, T (*getter)(), const char* format, uint16_t interval)
+        : BaseItemValue(text), getter(getter), format(format), interval(interval) {}
+    /**
+     * @brief Set the minimum time in milliseconds between two samples.
+     */
+    void setInterval(uint16_t interval) {
+        this->interval = interval;
+    }
+
+  protected:
+    /**
+     * @brief Read and format the current value.
+     */
+    void sample(unsigned long now) {
+        lastSample = now;
+        char formatted[ITEM_VALUE_BUFFER_SIZE];
+        snprintf(formatted, ITEM_VALUE_BUFFER_SIZE, format, value != nullptr ? *value : getter());
+        setValue(formatted);
+    }
+
+    bool poll(unsigned long now) override {
+        if ((uint32_t)(now - lastSample) >= interval) {
+            sample(now);
+        }
+        return changed;
+    }
+
+    void draw(MenuRenderer* renderer) override {
+        // Row scrolled into view may show a stale value, take a fresh one
+        sample(menuMillis());
+        BaseItemValue::draw(renderer);
+    }
+};
+
+/**
+ * @brief Create a new item showing a value set with `BaseItemValue::setValue` or posted through an `UpdateQueue`.
+ *
+ * @param text The text to display for the item.
+ * @return BaseItemValue* The created item, typed so it can be passed to `UpdateQueue::post`.
+ *         Caller takes ownership of the returned pointer.
+ *
+ * @example
+ *   BaseItemValue* status = ITEM_VALUE("Status");
+ */
+inline BaseItemValue* ITEM_VALUE(const char* text) {
+    return new BaseItemValue(text);
+}
+
+/**
+ * @brief Create a new item showing the value of a variable.
+ *
+ * @param text The text to display for the item.
+ * @param value Pointer to the variable to show.
+ * @param format The format of the value.
+ * @param interval Minimum time in milliseconds between two samples.
+ * @return MenuItem* The created item. Caller takes ownership of the returned pointer.
+ *
+ * @example
+ *   auto item = ITEM_VALUE("Temp", &temperature, "%.01f C");
+ */
+template <typename T>
+inline MenuItem* ITEM_VALUE(const char* text, const T* value, const char* format, uint16_t interval = 1000) {
+    return new ItemValue<T>(text, value, format, interval);
+}
+
+/**
+ * @brief Create a new item showing the value returned by a getter.
+ *
+ * @param text The text to display for the item.
+ * @param getter Function returning the value to show.
+ * @param format The format of the value.
+ * @param interval Minimum time in milliseconds between two samples.
+ * @return MenuItem* The created item. Caller takes ownership of the returned pointer.
+ *
+ * @example
+ *   int readLight() { return analogRead(A0); }
+ *   auto item = ITEM_VALUE("Light", readLight, "%d");
+ */
+template <typename T>
+inline MenuItem* ITEM_VALUE(const char* text, T (*getter)(), const char* format, uint16_t interval = 1000) {
+    return new ItemValue<T>(text, getter, format, interval);
+}
@@ -1,4 +1,6 @@
 #include "LcdMenu.h"
+#include "input/InputInterface.h"
+#include "utils/UpdateQueue.h"
 
 MenuRenderer* LcdMenu::getRenderer() {
     return &renderer;
@@ -11,19 +13,38 @@ MenuScreen* LcdMenu::getScreen() {
 void LcdMenu::setScreen(MenuScreen* screen) {
     LOG(F("LcdMenu::setScreen"));
     this->screen = screen;
-    renderer.display->clear();
+    this->screen->typeAhead[0] = '\0';
+    renderer.invalidate();
+    renderer.clear();
     this->screen->draw(&renderer);
+    renderer.display->commit();
 }
 
 bool LcdMenu::process(const unsigned char c) {
+    if (observer != NULL) {
+        observer->onInput(c);
+    }
     if (!enabled) {
         return false;
     }
-    return screen->process(this, c);
+    LATENCY_SCOPE(LATENCY_PROCESS);
+    LATENCY_INPUT();
+    bool asleep = renderer.getPower() >= DisplayPower::BACKLIGHT_OFF;
+    renderer.restartTimer();
+    if (asleep && consumeWakeKey) {
+        // Nothing was readable, the key only wakes the display up
+        return true;
+    }
+    bool processed = screen->process(this, c);
+    renderer.display->commit();
+    // Buffered displays took the input along with the frame, otherwise it's on the display now
+    LATENCY_GLASS();
+    return processed;
 };
 
 void LcdMenu::reset() {
     this->screen->setCursor(&renderer, 0);
+    renderer.display->commit();
 }
 
 void LcdMenu::hide() {
@@ -31,7 +52,9 @@ void LcdMenu::hide() {
         return;
     }
     enabled = false;
-    renderer.display->clear();
+    renderer.invalidate();
+    renderer.clear();
+    renderer.display->commit();
 }
 
 void LcdMenu::show() {
@@ -39,8 +62,9 @@ void LcdMenu::show() {
         return;
     }
     enabled = true;
-    renderer.display->clear();
+    renderer.clear();
     screen->draw(&renderer);
+    renderer.display->commit();
 }
 
 uint8_t LcdMenu::getCursor() {
@@ -52,6 +76,7 @@ void LcdMenu::setCursor(uint8_t cursor) {
         return;
     }
     screen->setCursor(&renderer, cursor);
+    renderer.display->commit();
 }
 
 MenuItem* LcdMenu::getItemAt(uint8_t position) {
@@ -63,4 +88,123 @@ void LcdMenu::refresh() {
         return;
     }
     screen->draw(&renderer);
+    renderer.display->commit();
+}
+
+void LcdMenu::setConsumeWakeKey(bool consume) {
+    consumeWakeKey = consume;
+}
+
+TimerWheel* LcdMenu::getTimers() {
+    return &timers;
+}
+
+unsigned long LcdMenu::poll() {
+    uint32_t now = menuMillis();
+    timers.poll(now);
+    if (updates != NULL) {
+        updates->drain();
+    }
+    if (enabled) {
+        screen->poll(&renderer);
+        renderer.display->commit();
+    }
+    return getWakeTime(now);
+}
+
+uint32_t LcdMenu::getWakeTime(uint32_t now) const {
+    uint32_t wake = now + POLL_MAX_SLEEP;
+    uint32_t deadline;
+    if (timers.getNextDeadline(deadline) && (int32_t)(deadline - wake) < 0) {
+        wake = deadline;
+    }
+    return wake;
+}
+
+bool LcdMenu::getIdleState(MenuIdleState& state) {
+    uint32_t now = menuMillis();
+    uint32_t deadline;
+    state.timers = timers.getNextDeadline(deadline);
+    state.renders = updates != NULL && updates->hasPending();
+    state.input = false;
+    for (InputInterface* input = inputs; input != NULL && !state.input; input = input->nextInput) {
+        state.input = input->hasPendingInput();
+    }
+    state.deadline = getWakeTime(now);
+    return !state.renders && !state.input;
+}
+
+uint8_t LcdMenu::getWakePins(void (*callback)(uint8_t pin)) {
+    uint8_t count = 0;
+    for (InputInterface* input = inputs; input != NULL; input = input->nextInput) {
+        const uint8_t* pins;
+        uint8_t size = input->getWakePins(pins);
+        for (uint8_t i = 0; i < size; i++) {
+            callback(pins[i]);
+        }
+        count += size;
+    }
+    return count;
+}
+
+void LcdMenu::setInputObserver(InputObserver* observer) {
+    this->observer = observer;
+}
+
+InputObserver* LcdMenu::getInputObserver() {
+    return observer;
+}
+
+void LcdMenu::addInput(InputInterface* input) {
+    input->nextInput = inputs;
+    inputs = input;
+}
+
+void LcdMenu::removeInput(InputInterface* input) {
+    InputInterface** link = &inputs;
+    while (*link != NULL && *link != input) {
+        link = &(*link)->nextInput;
+    }
+    if (*link == input) {
+        *link = input->nextInput;
+    }
+}
+
+void LcdMenu::setUpdateQueue(UpdateQueueInterface* updates) {
+    this->updates = updates;
+}
+
+void LcdMenu::setFilter(const char* filter) {
+    if (!enabled) {
+        return;
+    }
+    screen->setFilter(&renderer, filter);
+    renderer.display->commit();
+}
+
+bool LcdMenu::insertItem(uint8_t position, MenuItem* item) {
+    if (!enabled) {
+        return screen->insertItem(position, item);
+    }
+    bool inserted = screen->insertItem(&renderer, position, item);
+    renderer.display->commit();
+    return inserted;
+}
+
+MenuItem* LcdMenu::removeItem(uint8_t position) {
+    if (!enabled) {
+        return screen->removeItem(position);
+    }
+    MenuItem* removed = screen->removeItem(&renderer, position);
+    renderer.display->commit();
+    return removed;
+}
+
+MenuItem* LcdMenu::replaceItem(uint8_t position, MenuItem* item) {
+    if (!enabled) {
+        return screen->replaceItem(position, item);
+    }
+    MenuItem* replaced = screen->replaceItem(&renderer, position, item);
+    renderer.display->commit();
+    return replaced;
 }
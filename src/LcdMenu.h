@@ -27,10 +27,57 @@
 
 #include "MenuScreen.h"
 #include "renderer/MenuRenderer.h"
+#include "utils/TimerWheel.h"
 #include "utils/constants.h"
 #include <MenuItem.h>
 #include <utils/utils.h>
 
+class UpdateQueueInterface;
+class InputInterface;
+
+/**
+ * @brief Observer of the commands reaching `LcdMenu::process`, e.g. `InputRecorder`.
+ */
+class InputObserver {
+  public:
+    virtual ~InputObserver() = default;
+    /**
+     * @brief Called with every command passed to `LcdMenu::process`, before it is processed.
+     */
+    virtual void onInput(const unsigned char command) = 0;
+};
+
+/**
+ * @brief What the menu is waiting for, see `LcdMenu::getIdleState`.
+ */
+struct MenuIdleState {
+    /**
+     * @brief Any timer is armed.
+     */
+    bool timers;
+    /**
+     * @brief Updates are queued, the next `LcdMenu::poll` draws them.
+     */
+    bool renders;
+    /**
+     * @brief An input adapter has input which wasn't observed yet.
+     */
+    bool input;
+    /**
+     * @brief Time in milliseconds when `LcdMenu::poll` has to be called again.
+     */
+    unsigned long deadline;
+    /**
+     * @brief Get how long the MCU can sleep.
+     * @param now current time in milliseconds
+     * @return time in milliseconds until the deadline, 0 if there is work to do now
+     */
+    unsigned long getSleepTime(unsigned long now) const {
+        int32_t left = (int32_t)(deadline - now);
+        return renders || input || left <= 0 ? 0 : (unsigned long)left;
+    }
+};
+
 /**
  * @class LcdMenu
  * @brief Represents the main menu object.
@@ -56,12 +103,43 @@ class LcdMenu {
      * set it back to `true` to show the menu.
      */
     bool enabled = true;
+    /**
+     * @brief Queue of value updates posted by other tasks, drained in `poll`.
+     */
+    UpdateQueueInterface* updates = NULL;
+    /**
+     * @brief Timers of the menu, its renderer and input adapters, fired in `poll`.
+     */
+    TimerWheel timers;
+    /**
+     * @brief Whether a key pressed while the backlight or the display is off only wakes the display up.
+     */
+    bool consumeWakeKey = false;
+    /**
+     * @brief Observer of the processed commands.
+     */
+    InputObserver* observer = NULL;
+    /**
+     * @brief Input adapters of the menu, they add themselves when constructed.
+     */
+    InputInterface* inputs = NULL;
+    /**
+     * @brief Get the time `poll` has to be called again, the next deadline but at most `POLL_MAX_SLEEP` away.
+     */
+    uint32_t getWakeTime(uint32_t now) const;
 
   public:
     /**
      * Construct new instance of `LcdMenu`.
      */
-    LcdMenu(MenuRenderer& renderer) : renderer(renderer) {}
+    LcdMenu(MenuRenderer& renderer) : renderer(renderer) {
+        renderer.setTimers(&timers);
+    }
+    /**
+     * @brief Get the wheel the time driven parts of the menu schedule their timers on.
+     * Timers scheduled here are fired from `poll`.
+     */
+    TimerWheel* getTimers();
     /**
      * @brief Get the renderer.
      * @return the renderer
@@ -81,10 +159,18 @@ class LcdMenu {
     void setScreen(MenuScreen* screen);
     /**
      * @brief Process the input character.
+     * Any input wakes the display up, see `MenuRenderer::setPowerTimeouts`.
      * @param c the input character
      * @return `true` if the input was processed successfully
      */
     bool process(const unsigned char c);
+    /**
+     * @brief Set whether the key waking the display up is consumed.
+     * When the backlight or the display is off the user can't see what a key would do,
+     * a consumed key only wakes the display up. Keys are not consumed by default.
+     * @param consume `true` to only wake the display up, `false` to process the key as well
+     */
+    void setConsumeWakeKey(bool consume);
     /**
      * @brief Reset current screen to initial state.
      * Moves cursor and view positions to zero.
@@ -118,6 +204,86 @@ class LcdMenu {
     MenuItem* getItemAt(uint8_t position);
     /**
      * @brief Refresh the current screen.
+     * Only cells which changed are written, call `MenuRenderer::invalidate` first
+     * if the display was written to without the menu.
      */
     void refresh();
+    /**
+     * @brief Show only the items of current screen which text contains `filter`.
+     * Navigation, cursor and scroll indicators work over the matching items only.
+     * @param filter the substring to match (case-insensitive), `NULL` or empty string
+     * restores the full list and the cursor focused before filtering
+     */
+    void setFilter(const char* filter);
+    /**
+     * @brief Update live content of the current screen, call it from the `loop`.
+     * Due timers are fired first, e.g. the display timeout or idle input of the adapters,
+     * then pending updates of the attached queue are applied. Then items on the
+     * visible rows are re-sampled at their own rate and only the rows whose
+     * content changed are redrawn, without restarting the display timeout.
+     * The marquee of the focused row, see `MenuRenderer::setMarquee`, advances here as well.
+     * @return time in milliseconds when `poll` has to be called again, the next deadline
+     * but at most `POLL_MAX_SLEEP` away. Compare it as `(int32_t)(wake - menuMillis()) > 0`,
+     * so it works when the time wraps around.
+     */
+    unsigned long poll();
+    /**
+     * @brief Get what the menu is waiting for, to put the MCU to sleep in between.
+     * Call it after `poll`, sleep for `MenuIdleState::getSleepTime` and wake up on input,
+     * e.g. with interrupts on the pins of `getWakePins`.
+     * @param state set to the state of the menu
+     * @return true if there is nothing to do before the deadline
+     */
+    bool getIdleState(MenuIdleState& state);
+    /**
+     * @brief Call `callback` with every pin which wakes the MCU, as set with `InputInterface::setWakePins`.
+     * @param callback function attaching the interrupt of a pin
+     * @return number of pins
+     *
+     * @example
+     *   menu.getWakePins([](uint8_t pin) { attachInterrupt(digitalPinToInterrupt(pin), wake, CHANGE); });
+     */
+    uint8_t getWakePins(void (*callback)(uint8_t pin));
+    /**
+     * @brief Set the observer of the commands passed to `process`, whether the menu is enabled or not.
+     * @param observer the observer, `NULL` to detach
+     */
+    void setInputObserver(InputObserver* observer);
+    /**
+     * @brief Get the observer of the commands passed to `process`.
+     */
+    InputObserver* getInputObserver();
+    /**
+     * @brief Add an input adapter, called by `InputInterface`.
+     */
+    void addInput(InputInterface* input);
+    /**
+     * @brief Remove an input adapter, called by `InputInterface`.
+     */
+    void removeInput(InputInterface* input);
+    /**
+     * @brief Attach a queue through which other tasks post value updates.
+     * Pending updates are applied in `poll`, so only the task calling `poll` draws on the display.
+     * @param updates the queue, `NULL` to detach
+     */
+    void setUpdateQueue(UpdateQueueInterface* updates);
+    /**
+     * @brief Insert an item into the current screen.
+     * Only the rows which shifted are redrawn.
+     * @see MenuScreen::insertItem
+     */
+    bool insertItem(uint8_t position, MenuItem* item);
+    /**
+     * @brief Remove an item from the current screen.
+     * Only the rows which shifted are redrawn.
+     * @return the removed item, caller takes ownership of it
+     * @see MenuScreen::removeItem
+     */
+    MenuItem* removeItem(uint8_t position);
+    /**
+     * @brief Replace an item of the current screen and redraw its row.
+     * @return the replaced item, caller takes ownership of it
+     * @see MenuScreen::replaceItem
+     */
+    MenuItem* replaceItem(uint8_t position, MenuItem* item);
 };
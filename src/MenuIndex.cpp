@@ -0,0 +1,169 @@
+#include "MenuIndex.h"
+
+MenuIndex::~MenuIndex() {
+    delete[] entries;
+    delete[] order;
+}
+
+void MenuIndex::visit(MenuScreen* screen, uint16_t parent, uint32_t hash, MenuScreen** screens, uint8_t depth) {
+    screens[depth] = screen;
+    for (uint8_t position = 0; position < screen->getItemCount(); position++) {
+        if (count == MENU_INDEX_NONE) {
+            truncated = true;
+            return;
+        }
+        MenuItem* item = screen->getItemAt(position);
+        uint32_t itemHash = menuHash(item->getText(), parent == MENU_INDEX_NONE ? hash : menuHash("/", hash));
+        uint16_t index = count++;
+        if (entries != NULL) {
+            entries[index] = {item, screen, menuFold(itemHash), parent};
+        }
+        MenuScreen* subScreen = item->getSubScreen();
+        if (subScreen == NULL) {
+            continue;
+        }
+        bool loop = false;
+        for (uint8_t i = 0; i <= depth; i++) {
+            loop = loop || screens[i] == subScreen;
+        }
+        if (loop) {
+            // e.g. a "Back" submenu pointing to a screen above
+            continue;
+        }
+        if (depth + 1 >= MENU_INDEX_DEPTH) {
+            truncated = true;
+            continue;
+        }
+        visit(subScreen, index, itemHash, screens, depth + 1);
+    }
+}
+
+bool MenuIndex::build(MenuScreen* root) {
+    delete[] entries;
+    delete[] order;
+    entries = NULL;
+    order = NULL;
+    MenuScreen* screens[MENU_INDEX_DEPTH];
+    // Count first, so the table is allocated once with the exact size
+    count = 0;
+    truncated = false;
+    visit(root, MENU_INDEX_NONE, menuHash(""), screens, 0);
+    uint16_t size = count;
+    entries = new Entry[size];
+    order = new uint16_t[size];
+    if (entries == NULL || order == NULL) {
+        delete[] entries;
+        delete[] order;
+        entries = NULL;
+        order = NULL;
+        count = 0;
+        return false;
+    }
+    count = 0;
+    truncated = false;
+    visit(root, MENU_INDEX_NONE, menuHash(""), screens, 0);
+    // Insertion sort, the tree is mostly small and it runs once
+    collisions = 0;
+    for (uint16_t i = 0; i < count; i++) {
+        uint16_t index = i;
+        uint16_t j = i;
+        while (j > 0 && entries[order[j - 1]].id > entries[index].id) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = index;
+    }
+    for (uint16_t i = 1; i < count; i++) {
+        if (entries[order[i]].id == entries[order[i - 1]].id) {
+            collisions++;
+        }
+    }
+    return true;
+}
+
+uint16_t MenuIndex::lowerBound(uint16_t id) const {
+    uint16_t low = 0;
+    uint16_t high = count;
+    while (low < high) {
+        uint16_t middle = low + (high - low) / 2;
+        if (entries[order[middle]].id < id) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+bool MenuIndex::matches(uint16_t index, const char* path, size_t length) const {
+    size_t end = length;
+    while (index != MENU_INDEX_NONE) {
+        const Entry& entry = entries[index];
+        const char* text = entry.item->getText();
+        size_t textLength = strlen(text);
+        if (textLength > end || strncmp(path + end - textLength, text, textLength) != 0) {
+            return false;
+        }
+        end -= textLength;
+        if (entry.parent != MENU_INDEX_NONE) {
+            if (end == 0 || path[end - 1] != '/') {
+                return false;
+            }
+            end--;
+        }
+        index = entry.parent;
+    }
+    return end == 0;
+}
+
+const MenuIndex::Entry* MenuIndex::find(uint16_t id) const {
+    uint16_t position = lowerBound(id);
+    if (position < count && entries[order[position]].id == id) {
+        return &entries[order[position]];
+    }
+    return NULL;
+}
+
+const MenuIndex::Entry* MenuIndex::find(const char* path) const {
+    uint16_t id = MENU_ID(path);
+    size_t length = strlen(path);
+    for (uint16_t position = lowerBound(id); position < count && entries[order[position]].id == id; position++) {
+        if (matches(order[position], path, length)) {
+            return &entries[order[position]];
+        }
+    }
+    return NULL;
+}
+
+const MenuIndex::Entry* MenuIndex::getParent(const Entry* entry) const {
+    return entry->parent != MENU_INDEX_NONE ? &entries[entry->parent] : NULL;
+}
+
+MenuItem* MenuIndex::getItem(uint16_t id) const {
+    const Entry* entry = find(id);
+    return entry != NULL ? entry->item : NULL;
+}
+
+MenuItem* MenuIndex::getItem(const char* path) const {
+    const Entry* entry = find(path);
+    return entry != NULL ? entry->item : NULL;
+}
+
+MenuScreen* MenuIndex::getScreen(uint16_t id) const {
+    const Entry* entry = find(id);
+    return entry != NULL ? entry->screen : NULL;
+}
+
+MenuScreen* MenuIndex::getScreen(const char* path) const {
+    const Entry* entry = find(path);
+    return entry != NULL ? entry->screen : NULL;
+}
+
+uint16_t MenuIndex::getId(const MenuItem* item) const {
+    for (uint16_t i = 0; i < count; i++) {
+        if (entries[i].item == item) {
+            return entries[i].id;
+        }
+    }
+    return MENU_ID_NONE;
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "MenuItem.h"
+#include "MenuScreen.h"
+#include "utils/constants.h"
+
+/**
+ * @brief Index of no entry, e.g. the parent of the items of the root screen.
+ */
+#define MENU_INDEX_NONE 0xFFFF
+/**
+ * @brief ID of no item, `menuFold` never returns it.
+ */
+#define MENU_ID_NONE 0
+
+/**
+ * @brief FNV-1a hash of a text, continuing from `hash`.
+ * Evaluated by the compiler for literals, see `MENU_ID`.
+ */
+constexpr uint32_t menuHash(const char* text, uint32_t hash = 2166136261UL) {
+    return *text == '\0' ? hash : menuHash(text + 1, (hash ^ (uint8_t)*text) * 16777619UL);
+}
+
+/**
+ * @brief Fold a 16 bit hash into an ID, `MENU_ID_NONE` is moved to 1.
+ */
+constexpr uint16_t menuFoldId(uint16_t folded) {
+    return folded != MENU_ID_NONE ? folded : 1;
+}
+
+/**
+ * @brief Fold a hash of `menuHash` into a 16 bit ID, never `MENU_ID_NONE`.
+ */
+constexpr uint16_t menuFold(uint32_t hash) {
+    return menuFoldId((uint16_t)(hash ^ (hash >> 16)));
+}
+
+/**
+ * @brief ID of the item at `path`, a compile time constant for literals.
+ *
+ * @example
+ *   switch (id) {
+ *       case MENU_ID("Settings/Network/DHCP"):
+ *           ...
+ *   }
+ */
+#define MENU_ID(path) menuFold(menuHash(path))
+
+/**
+ * @class MenuIndex
+ * @brief Lookup table of all items of a menu tree, by stable ID or by path.
+ *
+ * The path of an item is the text of the items leading to it, separated by
+ * `/`, e.g. `"Settings/Network/DHCP"` is the `DHCP` item on the screen opened
+ * by `Network`, which is on the screen opened by `Settings`. The ID is a 16 bit
+ * hash of the path, so it doesn't change when items are moved around a screen
+ * and can be stored or sent to a remote instead of positions.
+ *
+ * `build` walks the screens once, following `ItemSubMenu`s, and allocates the
+ * table with exactly one entry per item. Lookups are binary searches, no screen
+ * is walked after that. Build the index again after adding or removing items.
+ *
+ * @example
+ *   MenuIndex index;
+ *   void setup() {
+ *       index.build(mainScreen);
+ *       MenuItem* dhcp = index.getItem("Settings/Network/DHCP");
+ *   }
+ */
+class MenuIndex {
+  public:
+    struct Entry {
+        MenuItem* item;
+        /**
+         * @brief Screen the item is on.
+         */
+        MenuScreen* screen;
+        uint16_t id;
+        /**
+         * @brief Index of the entry of the item opening `screen`, `MENU_INDEX_NONE` on the root screen.
+         */
+        uint16_t parent;
+    };
+
+  protected:
+    /**
+     * @brief Entries in the order of the tree, parents before their children.
+     */
+    Entry* entries = NULL;
+    /**
+     * @brief Indexes of `entries` sorted by ID.
+     */
+    uint16_t* order = NULL;
+    uint16_t count = 0;
+    uint16_t collisions = 0;
+    bool truncated = false;
+
+    /**
+     * @brief Count the items of `screen` and its sub-screens, or fill them in when `entries` is allocated.
+     * @param screens screens from the root down to `screen`, so loops back to them are not followed
+     */
+    void visit(MenuScreen* screen, uint16_t parent, uint32_t hash, MenuScreen** screens, uint8_t depth);
+    /**
+     * @brief Position in `order` of the first entry with an ID not less than `id`.
+     */
+    uint16_t lowerBound(uint16_t id) const;
+    /**
+     * @brief Check whether the path of the entry is `path`, walking its parents backwards.
+     */
+    bool matches(uint16_t index, const char* path, size_t length) const;
+
+  public:
+    MenuIndex() = default;
+    ~MenuIndex();
+
+    /**
+     * @brief Index all items reachable from `root`, dropping the previous table.
+     * @return `false` if the table couldn't be allocated
+     */
+    bool build(MenuScreen* root);
+    /**
+     * @brief Find the entry of an item by ID.
+     * @return the entry, or `NULL` if no item has the ID
+     */
+    const Entry* find(uint16_t id) const;
+    /**
+     * @brief Find the entry of an item by path, items with colliding IDs are told apart by their texts.
+     * @return the entry, or `NULL` if there is no item at the path
+     */
+    const Entry* find(const char* path) const;
+    /**
+     * @brief Get the entry of the item opening the screen of `entry`.
+     * @return the entry, or `NULL` for items on the root screen
+     */
+    const Entry* getParent(const Entry* entry) const;
+    MenuItem* getItem(uint16_t id) const;
+    MenuItem* getItem(const char* path) const;
+    /**
+     * @brief Get the screen the item is on, e.g. to show it with `LcdMenu::setScreen`.
+     */
+    MenuScreen* getScreen(uint16_t id) const;
+    MenuScreen* getScreen(const char* path) const;
+    /**
+     * @brief Get the ID of an item, by a linear search over the table.
+     * @return the ID, or `MENU_ID_NONE` if the item is not indexed
+     */
+    uint16_t getId(const MenuItem* item) const;
+    /**
+     * @brief Get number of indexed items.
+     */
+    uint16_t getCount() const { return count; }
+    /**
+     * @brief Get number of items sharing their ID with the item before them.
+     * Their IDs are ambiguous, `find` by ID returns one of them. Rename one of the items to fix it.
+     */
+    uint16_t getCollisions() const { return collisions; }
+    /**
+     * @brief Check whether screens nested deeper than `MENU_INDEX_DEPTH` were left out.
+     */
+    bool isTruncated() const { return truncated; }
+};
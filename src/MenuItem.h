@@ -67,6 +67,13 @@ class MenuItem {
     void setText(const char* text) {
         this->text = text;
     };
+    /**
+     * @brief Get the screen this item leads to, used by `MenuIndex` to walk the menu tree.
+     * @return the screen opened by the item, or `NULL` if it doesn't open one
+     */
+    virtual MenuScreen* getSubScreen() {
+        return NULL;
+    };
 
     // Destructor
     ~MenuItem() noexcept = default;
@@ -102,6 +109,14 @@ class MenuItem {
     virtual bool process(LcdMenu* menu, const unsigned char command) {
         return false;
     };
+    /**
+     * @brief Re-sample the content of the item, called periodically by `LcdMenu::poll` while the item is visible.
+     * @param now current time in milliseconds
+     * @return true if the content changed and the item's row needs to be redrawn.
+     */
+    virtual bool poll(unsigned long now) {
+        return false;
+    };
     /**
      * @brief Draw this menu item on specified display on current row.
      * @param renderer The renderer to use for drawing.
@@ -5,7 +5,22 @@ void MenuScreen::setParent(MenuScreen* parent) {
 }
 
 uint8_t MenuScreen::getCursor() {
-    return cursor;
+    if (visible != NULL && visibleCount == 0) {
+        return emptyFocus;
+    }
+    return positionAt(cursor);
+}
+
+void MenuScreen::setFilterable(bool filterable) {
+    this->filterable = filterable;
+}
+
+const char* MenuScreen::getFilter() {
+    return filterLength > 0 ? filter : "";
+}
+
+uint8_t MenuScreen::getVisibleCount() {
+    return visible != NULL ? visibleCount : itemCount;
 }
 
 MenuItem* MenuScreen::getItemAt(uint8_t position) {
@@ -16,8 +31,222 @@ MenuItem* MenuScreen::operator[](const uint8_t position) {
     return getItemAt(position);
 }
 
+uint8_t MenuScreen::indexOf(uint8_t position) const {
+    if (visible == NULL) {
+        return position;
+    }
+    uint8_t low = 0;
+    uint8_t high = visibleCount;
+    while (low < high) {
+        uint8_t middle = (low + high) / 2;
+        if (visible[middle] < position) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+bool MenuScreen::isVisible(uint8_t position) const {
+    return !isItemHidden(position) && (filterLength == 0 || matchDepth[position] == filterLength);
+}
+
+void MenuScreen::setItemHidden(uint8_t position, bool hidden) {
+    if (position >= itemCount || isItemHidden(position) == hidden) {
+        return;
+    }
+    if (hiddenFlags == NULL) {
+        hiddenFlags = new uint8_t[(itemCapacity + 7) / 8]();
+    }
+    uint8_t focused = getCursor();
+    uint8_t row = cursor - view;
+    bitWrite(hiddenFlags[position / 8], position % 8, hidden);
+    updateVisible();
+    locate(focused, row);
+}
+
+bool MenuScreen::isItemHidden(uint8_t position) const {
+    return hiddenFlags != NULL && bitRead(hiddenFlags[position / 8], position % 8);
+}
+
+void MenuScreen::setItemEnabled(uint8_t position, bool enabled) {
+    if (position >= itemCount || isItemEnabled(position) == enabled) {
+        return;
+    }
+    if (disabledFlags == NULL) {
+        disabledFlags = new uint8_t[(itemCapacity + 7) / 8]();
+        nextEnabled = new uint8_t[itemCapacity];
+        previousEnabled = new uint8_t[itemCapacity];
+    }
+    uint8_t focused = getCursor();
+    uint8_t row = cursor - view;
+    bitWrite(disabledFlags[position / 8], position % 8, !enabled);
+    updateVisible();
+    locate(focused, row);
+}
+
+bool MenuScreen::isItemEnabled(uint8_t position) const {
+    return disabledFlags == NULL || !bitRead(disabledFlags[position / 8], position % 8);
+}
+
+void MenuScreen::updateVisible() {
+    if (visible == NULL) {
+        visible = new uint8_t[itemCapacity]();
+    }
+    visibleCount = 0;
+    for (uint8_t i = 0; i < itemCount; i++) {
+        if (isVisible(i)) {
+            visible[visibleCount++] = i;
+        }
+    }
+    if (disabledFlags == NULL) {
+        return;
+    }
+    // Two passes over the visible sequence, each index points to the closest enabled neighbour
+    uint8_t last = 0;
+    bool found = false;
+    for (uint8_t i = 0; i < visibleCount; i++) {
+        previousEnabled[i] = found ? last : i;
+        if (isItemEnabled(visible[i])) {
+            last = i;
+            found = true;
+        }
+    }
+    found = false;
+    for (uint8_t i = visibleCount; i-- > 0;) {
+        nextEnabled[i] = found ? last : i;
+        if (isItemEnabled(visible[i])) {
+            last = i;
+            found = true;
+        }
+    }
+}
+
+uint8_t MenuScreen::enabledFrom(uint8_t index) const {
+    if (disabledFlags == NULL || isItemEnabled(visible[index])) {
+        return index;
+    }
+    return nextEnabled[index] != index ? nextEnabled[index] : previousEnabled[index];
+}
+
+void MenuScreen::locate(uint8_t position, uint8_t row) {
+    uint8_t size = getVisibleCount();
+    if (size == 0) {
+        emptyFocus = itemCount > 0 ? min(position, (uint8_t)(itemCount - 1)) : 0;
+        cursor = 0;
+        view = 0;
+        return;
+    }
+    uint8_t index = indexOf(position);
+    cursor = enabledFrom(index < size ? index : size - 1);
+    view = row < cursor ? cursor - row : 0;
+}
+
+void MenuScreen::focus(MenuRenderer* renderer, uint8_t position, uint8_t row) {
+    locate(position, row);
+    renderer->viewShift = 0;
+    draw(renderer);
+}
+
+bool MenuScreen::pushFilter(const char character) {
+    if (filter == NULL) {
+        filter = new char[FILTER_BUFFER_SIZE];
+        matchDepth = new uint8_t[itemCapacity]();
+    }
+    if (filterLength >= FILTER_BUFFER_SIZE - 1) {
+        return false;
+    }
+    filter[filterLength++] = character;
+    filter[filterLength] = '\0';
+    // Only items which matched the shorter filter can match the longer one
+    for (uint8_t i = 0; i < itemCount; i++) {
+        if (matchDepth[i] == filterLength - 1 && containsIgnoreCase(items[i]->getText(), filter)) {
+            matchDepth[i] = filterLength;
+        }
+    }
+    return true;
+}
+
+void MenuScreen::popFilter() {
+    if (filterLength == 0) {
+        return;
+    }
+    filter[--filterLength] = '\0';
+    // Everything that matched the longer filter matches the shorter one as well
+    for (uint8_t i = 0; i < itemCount; i++) {
+        if (matchDepth[i] > filterLength) {
+            matchDepth[i] = filterLength;
+        }
+    }
+}
+
+void MenuScreen::setFilter(MenuRenderer* renderer, const char* filter) {
+    bool wasFiltered = filterLength > 0;
+    if (!wasFiltered && (filter == NULL || *filter == '\0')) {
+        return;
+    }
+    uint8_t position = getCursor();
+    uint8_t row = cursor - view;
+    if (!wasFiltered) {
+        unfilteredPosition = position;
+        unfilteredRow = row;
+    }
+    while (filterLength > 0) {
+        popFilter();
+    }
+    if (filter != NULL) {
+        for (const char* c = filter; *c && pushFilter(*c); c++);
+    }
+    updateVisible();
+    if (filterLength == 0) {
+        focus(renderer, unfilteredPosition, unfilteredRow);
+    } else {
+        focus(renderer, position, row);
+    }
+    LOG(F("MenuScreen::filter"), getFilter());
+}
+
+bool MenuScreen::appendFilter(MenuRenderer* renderer, const unsigned char character) {
+    uint8_t position = getCursor();
+    uint8_t row = cursor - view;
+    if (filterLength == 0) {
+        unfilteredPosition = position;
+        unfilteredRow = row;
+    }
+    if (!pushFilter(character)) {
+        return false;
+    }
+    updateVisible();
+    focus(renderer, position, row);
+    LOG(F("MenuScreen::filter"), getFilter());
+    return true;
+}
+
+void MenuScreen::removeFilter(MenuRenderer* renderer) {
+    if (filterLength == 1) {
+        clearFilter(renderer);
+        return;
+    }
+    uint8_t position = getCursor();
+    uint8_t row = cursor - view;
+    popFilter();
+    updateVisible();
+    focus(renderer, position, row);
+    LOG(F("MenuScreen::filter"), getFilter());
+}
+
+void MenuScreen::clearFilter(MenuRenderer* renderer) {
+    setFilter(renderer, NULL);
+}
+
 void MenuScreen::setCursor(MenuRenderer* renderer, uint8_t position) {
-    uint8_t constrained = constrain(position, 0, itemCount - 1);
+    uint8_t size = getVisibleCount();
+    if (size == 0) {
+        return;
+    }
+    uint8_t constrained = indexOf(position);
+    constrained = enabledFrom(constrained < size ? constrained : size - 1);
     if (constrained == cursor) {
         return;
     }
@@ -27,25 +256,74 @@ void MenuScreen::setCursor(MenuRenderer* renderer, uint8_t position) {
     } else if (constrained > (view + (viewSize - 1))) {
         view = constrained - (viewSize - 1);
     }
-    cursor = position;
+    cursor = constrained;
     draw(renderer);
 }
 
+void MenuScreen::fitView(uint8_t viewSize) {
+    uint8_t size = getVisibleCount();
+    // Keep cursor inside the view and don't leave empty rows at the bottom when there are enough items
+    if (cursor < view) {
+        view = cursor;
+    } else if (cursor >= view + viewSize) {
+        view = cursor - (viewSize - 1);
+    }
+    if (size <= viewSize) {
+        view = 0;
+    } else if (view > size - viewSize) {
+        view = size - viewSize;
+    }
+}
+
 void MenuScreen::draw(MenuRenderer* renderer) {
+    LATENCY_SCOPE(LATENCY_DRAW);
     renderer->restartTimer();
-    for (uint8_t i = 0; i < renderer->maxRows; i++) {
-        MenuItem* item = this->items[view + i];
-        if (item == nullptr) {
-            break;
-        }
+    fitView(renderer->maxRows);
+    drawRows(renderer, 0, renderer->maxRows);
+}
+
+void MenuScreen::drawRows(MenuRenderer* renderer, uint8_t from, uint8_t to) {
+    uint8_t size = getVisibleCount();
+    uint8_t cursorCol = renderer->cursorCol;
+    uint8_t cursorRow = renderer->cursorRow;
+    bool focusDrawn = false;
+    for (uint8_t i = from; i < to && i < renderer->maxRows; i++) {
         syncIndicators(i, renderer);
-        item->draw(renderer);
+        if (view + i < size) {
+            focusDrawn |= renderer->hasFocus;
+            items[positionAt(view + i)]->draw(renderer);
+        } else {
+            // Blank rows left after the visible sequence got shorter
+            renderer->hasFocus = false;
+            renderer->drawItem("", NULL);
+        }
+    }
+    // Focused row places the cursor itself, otherwise put it back where it was
+    if (!focusDrawn && from < to) {
+        renderer->moveCursor(cursorCol, cursorRow);
     }
 }
 
+bool MenuScreen::poll(MenuRenderer* renderer) {
+    uint8_t size = getVisibleCount();
+    uint32_t now = menuMillis();
+    bool changed = false;
+    for (uint8_t i = 0; i < renderer->maxRows && view + i < size; i++) {
+        if (items[positionAt(view + i)]->poll(now)) {
+            drawRows(renderer, i, i + 1);
+            changed = true;
+        }
+    }
+    if (renderer->takeMarqueeStep() && size > 0) {
+        drawRows(renderer, cursor - view, cursor - view + 1);
+        changed = true;
+    }
+    return changed;
+}
+
 void MenuScreen::syncIndicators(uint8_t index, MenuRenderer* renderer) {
     renderer->hasHiddenItemsAbove = index == 0 && view > 0;
-    renderer->hasHiddenItemsBelow = index == renderer->maxRows - 1 && (view + renderer->maxRows) < itemCount;
+    renderer->hasHiddenItemsBelow = index == renderer->maxRows - 1 && (view + renderer->maxRows) < getVisibleCount();
     renderer->hasFocus = cursor == view + index;
     renderer->cursorRow = index;
 }
@@ -53,7 +331,11 @@ void MenuScreen::syncIndicators(uint8_t index, MenuRenderer* renderer) {
 bool MenuScreen::process(LcdMenu* menu, const unsigned char command) {
     MenuRenderer* renderer = menu->getRenderer();
     syncIndicators(cursor - view, renderer);
-    if (items[cursor]->process(menu, command)) return true;
+    if (getVisibleCount() > 0 && isItemEnabled(positionAt(cursor)) && items[positionAt(cursor)]->process(menu, command)) return true;
+    if (!isprint(command)) {
+        // Any navigation starts a new type-ahead prefix
+        typeAhead[0] = '\0';
+    }
     switch (command) {
         case UP:
             renderer->viewShift = 0;
@@ -65,6 +347,10 @@ bool MenuScreen::process(LcdMenu* menu, const unsigned char command) {
             return true;
         case BACK:
             renderer->viewShift = 0;
+            if (filterable && filterLength > 0) {
+                clearFilter(renderer);
+                return true;
+            }
             if (parent != NULL) {
                 menu->setScreen(parent);
             }
@@ -84,35 +370,364 @@ bool MenuScreen::process(LcdMenu* menu, const unsigned char command) {
             }
             LOG(F("MenuScreen::left"), renderer->viewShift);
             return true;
+        case BACKSPACE:
+            if (filterable && filterLength > 0) {
+                removeFilter(renderer);
+                return true;
+            }
+            return false;
         default:
+            if (isprint(command)) {
+                return filterable ? appendFilter(renderer, command) : typeAheadSearch(renderer, command);
+            }
             return false;
     }
 }
 
 void MenuScreen::up(MenuRenderer* renderer) {
-    if (cursor > 0) {
-        if (--cursor < view) view--;
+    if (getVisibleCount() == 0) {
+        return;
+    }
+    uint8_t previous = previousEnabled != NULL ? previousEnabled[cursor] : (cursor > 0 ? cursor - 1 : cursor);
+    if (previous < cursor) {
+        cursor = previous;
+        if (cursor < view) view = cursor;
         draw(renderer);
     }
-    LOG(F("MenuScreen::up"), cursor);
+    LOG(F("MenuScreen::up"), getCursor());
 }
 
 void MenuScreen::down(MenuRenderer* renderer) {
-    if (cursor < itemCount - 1) {
-        if (++cursor > view + renderer->maxRows - 1) view++;
+    if (getVisibleCount() == 0) {
+        return;
+    }
+    uint8_t next = nextEnabled != NULL ? nextEnabled[cursor] : (cursor + 1 < getVisibleCount() ? cursor + 1 : cursor);
+    if (next > cursor) {
+        cursor = next;
+        if (cursor > view + renderer->maxRows - 1) view = cursor - (renderer->maxRows - 1);
         draw(renderer);
     }
-    LOG(F("MenuScreen::down"), cursor);
+    LOG(F("MenuScreen::down"), getCursor());
 }
 
 void MenuScreen::reset(MenuRenderer* renderer) {
-    cursor = 0;
+    cursor = getVisibleCount() > 0 ? enabledFrom(0) : 0;
     view = 0;
     draw(renderer);
 }
 
+void MenuScreen::invalidateSearchIndex() {
+    delete[] searchIndex;
+    searchIndex = NULL;
+}
+
+void MenuScreen::buildSearchIndex() {
+    if (searchIndex != NULL) {
+        return;
+    }
+    searchIndex = new uint8_t[itemCount];
+    // Insertion sort, it is stable and runs only once per screen
+    for (uint8_t i = 0; i < itemCount; i++) {
+        uint8_t j = i;
+        while (j > 0 && strcasecmp(items[searchIndex[j - 1]]->getText(), items[i]->getText()) > 0) {
+            searchIndex[j] = searchIndex[j - 1];
+            j--;
+        }
+        searchIndex[j] = i;
+    }
+}
+
+uint8_t MenuScreen::findByPrefix(const char* prefix, uint8_t from) {
+    buildSearchIndex();
+    size_t length = strlen(prefix);
+    // Lower bound: first entry which text is not less than the prefix
+    uint8_t low = 0;
+    uint8_t high = itemCount;
+    while (low < high) {
+        uint8_t middle = (low + high) / 2;
+        if (strncasecmp(items[searchIndex[middle]]->getText(), prefix, length) < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    // All matches are contiguous from `low`, pick the first one at or after `from`
+    uint8_t found = itemCount;
+    uint8_t first = itemCount;
+    for (uint8_t i = low; i < itemCount && strncasecmp(items[searchIndex[i]]->getText(), prefix, length) == 0; i++) {
+        uint8_t position = searchIndex[i];
+        if (!isVisible(position) || !isItemEnabled(position)) continue;
+        if (position < first) first = position;
+        if (position >= from && position < found) found = position;
+    }
+    return found < itemCount ? found : first;
+}
+
+bool MenuScreen::typeAheadSearch(MenuRenderer* renderer, const unsigned char character) {
+    uint32_t now = menuMillis();
+    uint8_t length = strlen(typeAhead);
+    if (now - typeAheadTimestamp > TYPE_AHEAD_TIMEOUT) {
+        length = 0;
+    }
+    if (length < TYPE_AHEAD_BUFFER_SIZE - 1) {
+        typeAhead[length++] = character;
+        typeAhead[length] = '\0';
+    }
+    typeAheadTimestamp = now;
+    // Same letter typed repeatedly cycles over items starting with it,
+    // otherwise stay on the current item while it still matches the prefix
+    bool cycle = true;
+    for (uint8_t i = 1; i < length && cycle; i++) {
+        cycle = tolower(typeAhead[i]) == tolower(typeAhead[0]);
+    }
+    uint8_t position = cycle
+                           ? findByPrefix(typeAhead + length - 1, getCursor() + 1)
+                           : findByPrefix(typeAhead, getCursor());
+    LOG(F("MenuScreen::typeAhead"), typeAhead);
+    if (position >= itemCount) {
+        return false;
+    }
+    renderer->viewShift = 0;
+    setCursor(renderer, position);
+    return true;
+}
+
+uint8_t MenuScreen::getItemCount() {
+    return itemCount;
+}
+
+/**
+ * @brief Reallocate array to a bigger size keeping its content, new part is zeroed.
+ */
+static void grow(uint8_t*& array, size_t size, size_t newSize) {
+    if (array == NULL) {
+        return;
+    }
+    uint8_t* grown = new uint8_t[newSize]();
+    memcpy(grown, array, size);
+    delete[] array;
+    array = grown;
+}
+
+/**
+ * @brief Open a cleared bit at position in a packed bitmap of `count` bits (count includes the new bit).
+ */
+static void insertFlag(uint8_t* flags, uint8_t position, uint8_t count) {
+    if (flags == NULL) {
+        return;
+    }
+    for (uint8_t i = count - 1; i > position; i--) {
+        bitWrite(flags[i / 8], i % 8, bitRead(flags[(i - 1) / 8], (i - 1) % 8));
+    }
+    bitClear(flags[position / 8], position % 8);
+}
+
+/**
+ * @brief Remove the bit at position from a packed bitmap of `count` bits.
+ */
+static void removeFlag(uint8_t* flags, uint8_t position, uint8_t count) {
+    if (flags == NULL) {
+        return;
+    }
+    for (uint8_t i = position; i + 1 < count; i++) {
+        bitWrite(flags[i / 8], i % 8, bitRead(flags[(i + 1) / 8], (i + 1) % 8));
+    }
+    bitClear(flags[(count - 1) / 8], (count - 1) % 8);
+}
+
+void MenuScreen::ownItems() {
+    if (ownsItems) {
+        return;
+    }
+    MenuItem** slots = new MenuItem*[itemCapacity + 1];
+    memcpy(slots, items, (itemCount + 1) * sizeof(MenuItem*));
+    items = slots;
+    ownsItems = true;
+}
+
+bool MenuScreen::reserve(uint8_t capacity) {
+    if (capacity <= itemCapacity) {
+        return true;
+    }
+    MenuItem** slots = new MenuItem*[capacity + 1];
+    memcpy(slots, items, (itemCount + 1) * sizeof(MenuItem*));
+    if (ownsItems) {
+        delete[] items;
+    }
+    items = slots;
+    ownsItems = true;
+    grow(visible, itemCapacity, capacity);
+    grow(matchDepth, itemCapacity, capacity);
+    grow(nextEnabled, itemCapacity, capacity);
+    grow(previousEnabled, itemCapacity, capacity);
+    grow(hiddenFlags, (itemCapacity + 7) / 8, (capacity + 7) / 8);
+    grow(disabledFlags, (itemCapacity + 7) / 8, (capacity + 7) / 8);
+    itemCapacity = capacity;
+    return true;
+}
+
+uint8_t MenuScreen::matchFilter(MenuItem* item) {
+    uint8_t depth = 0;
+    while (depth < filterLength) {
+        // Temporarily cut the filter after the next character
+        char next = filter[depth + 1];
+        filter[depth + 1] = '\0';
+        bool matched = containsIgnoreCase(item->getText(), filter);
+        filter[depth + 1] = next;
+        if (!matched) break;
+        depth++;
+    }
+    return depth;
+}
+
+void MenuScreen::relocate(uint8_t focused, uint8_t position, uint8_t oldSize) {
+    if (visible != NULL) {
+        updateVisible();
+    }
+    uint8_t oldView = view;
+    locate(focused, 0);
+    view = oldView;
+    // Change above the view scrolls it along, so the visible rows keep their items
+    int16_t shift = (int16_t)getVisibleCount() - oldSize;
+    if (indexOf(position) < oldView && oldView + shift >= 0) {
+        view = oldView + shift;
+    }
+}
+
+bool MenuScreen::insertItem(uint8_t position, MenuItem* item) {
+    if (item == NULL || position > itemCount || itemCount == UINT8_MAX) {
+        return false;
+    }
+    ownItems();
+    if (itemCount == itemCapacity) {
+        reserve(itemCount < 4 ? 4 : (itemCount > UINT8_MAX / 2 ? UINT8_MAX : itemCount * 2));
+    }
+    uint8_t oldSize = getVisibleCount();
+    uint8_t focused = getCursor();
+    if (itemCount > 0 && focused >= position) {
+        focused++;
+    }
+    // Shift the tail including the terminating `nullptr`
+    memmove(items + position + 1, items + position, (itemCount - position + 1) * sizeof(MenuItem*));
+    items[position] = item;
+    itemCount++;
+    insertFlag(hiddenFlags, position, itemCount);
+    insertFlag(disabledFlags, position, itemCount);
+    if (matchDepth != NULL) {
+        memmove(matchDepth + position + 1, matchDepth + position, itemCount - position - 1);
+        matchDepth[position] = matchFilter(item);
+    }
+    invalidateSearchIndex();
+    relocate(focused, position, oldSize);
+    LOG(F("MenuScreen::insertItem"), position);
+    return true;
+}
+
+MenuItem* MenuScreen::removeItem(uint8_t position) {
+    if (position >= itemCount) {
+        return NULL;
+    }
+    ownItems();
+    MenuItem* removed = items[position];
+    uint8_t oldSize = getVisibleCount();
+    uint8_t focused = getCursor();
+    if (focused > position) {
+        focused--;
+    }
+    removeFlag(hiddenFlags, position, itemCount);
+    removeFlag(disabledFlags, position, itemCount);
+    if (matchDepth != NULL) {
+        memmove(matchDepth + position, matchDepth + position + 1, itemCount - position - 1);
+    }
+    memmove(items + position, items + position + 1, (itemCount - position) * sizeof(MenuItem*));
+    itemCount--;
+    invalidateSearchIndex();
+    relocate(focused < itemCount ? focused : itemCount - 1, position, oldSize);
+    LOG(F("MenuScreen::removeItem"), position);
+    return removed;
+}
+
+MenuItem* MenuScreen::replaceItem(uint8_t position, MenuItem* item) {
+    if (item == NULL || position >= itemCount) {
+        return NULL;
+    }
+    ownItems();
+    MenuItem* replaced = items[position];
+    items[position] = item;
+    invalidateSearchIndex();
+    if (matchDepth != NULL) {
+        uint8_t oldSize = getVisibleCount();
+        uint8_t focused = getCursor();
+        matchDepth[position] = matchFilter(item);
+        relocate(focused, position, oldSize);
+    }
+    LOG(F("MenuScreen::replaceItem"), position);
+    return replaced;
+}
+
+void MenuScreen::drawChanged(MenuRenderer* renderer, uint8_t oldView, uint8_t oldSize, uint8_t from, uint8_t to) {
+    uint8_t viewSize = renderer->maxRows;
+    uint8_t size = getVisibleCount();
+    fitView(viewSize);
+    uint8_t first = viewSize;
+    uint8_t last = viewSize;
+    if (view == oldView && from >= view) {
+        // Only rows from the change downwards have shifted
+        first = from - view < viewSize ? from - view : viewSize;
+        last = to - view < viewSize ? to - view : viewSize;
+    } else if (from >= view || view - oldView != size - oldSize) {
+        // View has moved on its own, every row shows another item
+        first = 0;
+    }
+    drawRows(renderer, first, last);
+    // Scroll indicators may change even if the rows kept their items
+    if (first > 0 && (view > 0) != (oldView > 0)) {
+        drawRows(renderer, 0, 1);
+    }
+    bool lastRowDrawn = first < viewSize && last == viewSize;
+    if (!lastRowDrawn && (view + viewSize < size) != (oldView + viewSize < oldSize)) {
+        drawRows(renderer, viewSize - 1, viewSize);
+    }
+}
+
+bool MenuScreen::insertItem(MenuRenderer* renderer, uint8_t position, MenuItem* item) {
+    uint8_t oldView = view;
+    uint8_t oldSize = getVisibleCount();
+    if (!insertItem(position, item)) {
+        return false;
+    }
+    drawChanged(renderer, oldView, oldSize, indexOf(position), UINT8_MAX);
+    return true;
+}
+
+MenuItem* MenuScreen::removeItem(MenuRenderer* renderer, uint8_t position) {
+    uint8_t oldView = view;
+    uint8_t oldSize = getVisibleCount();
+    MenuItem* removed = removeItem(position);
+    if (removed != NULL) {
+        drawChanged(renderer, oldView, oldSize, indexOf(position), UINT8_MAX);
+    }
+    return removed;
+}
+
+MenuItem* MenuScreen::replaceItem(MenuRenderer* renderer, uint8_t position, MenuItem* item) {
+    uint8_t oldView = view;
+    uint8_t oldSize = getVisibleCount();
+    MenuItem* replaced = replaceItem(position, item);
+    if (replaced != NULL) {
+        uint8_t index = indexOf(position);
+        if (oldSize == getVisibleCount()) {
+            drawChanged(renderer, oldView, oldSize, index, index + 1);
+        } else {
+            drawChanged(renderer, oldView, oldSize, index, UINT8_MAX);
+        }
+    }
+    return replaced;
+}
+
 MenuScreen::MenuScreen(MenuItem** items) : items(items) {
     while (items[itemCount] != nullptr) {
         itemCount++;
     }
+    itemCapacity = itemCount;
 }
\ No newline at end of file
@@ -43,6 +43,7 @@ class MenuScreen {
      *
      * When `up` or `down` then this position will be moved over the items accordingly.
      * Always in range [`view`, `view` + `renderer.getMaxRows()` - 1].
+     * It is an index in the sequence of visible items, use `positionAt` to get the item position.
      */
     uint8_t cursor = 0;
     /**
@@ -68,6 +69,87 @@ class MenuScreen {
     uint8_t view = 0;
 
     uint8_t itemCount = 0;
+    /**
+     * @brief Number of slots available in `items` and the per-item arrays before they have to grow.
+     */
+    uint8_t itemCapacity = 0;
+    /**
+     * @brief Whether `items` was allocated by this screen.
+     * The array passed to the constructor is copied on the first insertion or removal.
+     */
+    bool ownsItems = false;
+    /**
+     * @brief Positions of the items currently visible on the screen, in ascending order.
+     * `cursor` and `view` are indexes in this array.
+     * Allocated when the screen is filtered for the first time, until then all items are visible
+     * and index equals position.
+     */
+    uint8_t* visible = NULL;
+    /**
+     * @brief Number of entries in `visible`.
+     */
+    uint8_t visibleCount = 0;
+    /**
+     * @brief Substring the items are filtered by, allocated on first use.
+     */
+    char* filter = NULL;
+    /**
+     * @brief Length of `filter`, `0` when the screen is not filtered.
+     */
+    uint8_t filterLength = 0;
+    /**
+     * @brief For each item, how many leading characters of `filter` it contains.
+     * Item is matched when its depth equals `filterLength`. Appending a character only
+     * re-checks items that matched before, removing one never needs any string search.
+     */
+    uint8_t* matchDepth = NULL;
+    /**
+     * @brief When `true` printable characters filter the screen instead of type-ahead search.
+     */
+    bool filterable = false;
+    /**
+     * @brief Packed bitmap of hidden items, bit per item position. Allocated on first use.
+     */
+    uint8_t* hiddenFlags = NULL;
+    /**
+     * @brief Packed bitmap of disabled items, bit per item position. Allocated on first use.
+     */
+    uint8_t* disabledFlags = NULL;
+    /**
+     * @brief For each visible index, the index of the next enabled item (or itself if there is none).
+     * Lets `down` skip disabled items without rescanning. Allocated with `disabledFlags`.
+     */
+    uint8_t* nextEnabled = NULL;
+    /**
+     * @brief For each visible index, the index of the previous enabled item (or itself if there is none).
+     */
+    uint8_t* previousEnabled = NULL;
+    /**
+     * @brief Item position focused before the filter was applied, restored when it is cleared.
+     */
+    uint8_t unfilteredPosition = 0;
+    /**
+     * @brief Row of the focused item before the filter was applied.
+     */
+    uint8_t unfilteredRow = 0;
+    /**
+     * @brief Item position focused before all items were filtered out or hidden, kept as focus while none is visible.
+     */
+    uint8_t emptyFocus = 0;
+    /**
+     * @brief Positions of the items sorted by their text (case-insensitive).
+     * Built lazily on the first type-ahead search, so screens that are never
+     * searched don't pay for it. Items with equal text keep their original order.
+     */
+    uint8_t* searchIndex = NULL;
+    /**
+     * @brief Characters typed so far for the type-ahead search.
+     */
+    char typeAhead[TYPE_AHEAD_BUFFER_SIZE] = {0};
+    /**
+     * @brief Milliseconds timestamp of the last type-ahead character.
+     */
+    uint32_t typeAheadTimestamp = 0;
 
   public:
     /**
@@ -80,8 +162,45 @@ class MenuScreen {
     void setParent(MenuScreen* parent);
     /**
      * @brief Get current cursor position.
+     * @return position of the focused item in the items array, or of the item focused
+     *         before all items were filtered out or hidden
      */
     uint8_t getCursor();
+    /**
+     * @brief Enable filtering by typing.
+     * When enabled, printable characters narrow the screen to items containing the typed text,
+     * `BACKSPACE` removes the last character and `BACK` clears the filter.
+     */
+    void setFilterable(bool filterable);
+    /**
+     * @brief Get the current filter.
+     * @return the substring the items are filtered by, empty when not filtered
+     */
+    const char* getFilter();
+    /**
+     * @brief Get number of items currently visible on the screen.
+     */
+    uint8_t getVisibleCount();
+    /**
+     * @brief Hide or show the item at position.
+     * Hidden items are skipped by navigation, drawing and the scroll indicators.
+     * @note You need to call `LcdMenu::refresh` after this method to see the changes.
+     */
+    void setItemHidden(uint8_t position, bool hidden);
+    /**
+     * @brief Check whether the item at position is hidden.
+     */
+    bool isItemHidden(uint8_t position) const;
+    /**
+     * @brief Enable or disable the item at position.
+     * Disabled items are drawn, but the cursor skips them and they receive no commands.
+     * @note You need to call `LcdMenu::refresh` after this method to see the changes.
+     */
+    void setItemEnabled(uint8_t position, bool enabled);
+    /**
+     * @brief Check whether the item at position can be focused.
+     */
+    bool isItemEnabled(uint8_t position) const;
     /**
      * @brief Get a `MenuItem` at position.
      * @return `MenuItem` - item at `position`
@@ -92,8 +211,161 @@ class MenuScreen {
      * @return `MenuItem` - item at `position`
      */
     MenuItem* operator[](const uint8_t position);
+    /**
+     * @brief Get number of items on the screen, including hidden ones.
+     */
+    uint8_t getItemCount();
+    /**
+     * @brief Make room for `capacity` items, so later insertions don't reallocate.
+     * @return `true` if the screen can hold `capacity` items
+     */
+    bool reserve(uint8_t capacity);
+    /**
+     * @brief Insert an item at position, following items are shifted down.
+     * Cursor stays on the focused item.
+     * @note You need to call `LcdMenu::refresh` after this method to see the changes,
+     *       or use `LcdMenu::insertItem` to only redraw the rows that shifted.
+     * @param position position of the new item, from `0` to `getItemCount()`
+     * @param item the item to insert
+     * @return `true` if the item was inserted
+     */
+    bool insertItem(uint8_t position, MenuItem* item);
+    /**
+     * @brief Remove the item at position, following items are shifted up.
+     * Cursor stays on the focused item, or moves to the next one if the focused item is removed.
+     * @note You need to call `LcdMenu::refresh` after this method to see the changes,
+     *       or use `LcdMenu::removeItem` to only redraw the rows that shifted.
+     * @return the removed item, caller takes ownership of it, or `NULL` if position is out of range
+     */
+    MenuItem* removeItem(uint8_t position);
+    /**
+     * @brief Replace the item at position, keeping its hidden and enabled flags.
+     * @note You need to call `LcdMenu::refresh` after this method to see the changes,
+     *       or use `LcdMenu::replaceItem` to only redraw its row.
+     * @return the replaced item, caller takes ownership of it, or `NULL` if position is out of range
+     */
+    MenuItem* replaceItem(uint8_t position, MenuItem* item);
+    /**
+     * @brief Drop the type-ahead search index.
+     * Call it after changing the text of items on this screen, the index
+     * will be rebuilt on the next search.
+     */
+    void invalidateSearchIndex();
 
   protected:
+    /**
+     * @brief Get the item position at index of the visible sequence.
+     */
+    inline uint8_t positionAt(uint8_t index) const {
+        return visible != NULL ? visible[index] : index;
+    }
+    /**
+     * @brief Get the index in the visible sequence of the item at position.
+     * @return index of the item, or of the next visible one when it is not visible
+     */
+    uint8_t indexOf(uint8_t position) const;
+    /**
+     * @brief Check whether the item at position is not hidden and passes the filter.
+     */
+    bool isVisible(uint8_t position) const;
+    /**
+     * @brief Rebuild `visible`, `nextEnabled` and `previousEnabled` from the flags and the filter.
+     */
+    void updateVisible();
+    /**
+     * @brief Get the closest enabled index to `index`, looking forward first.
+     */
+    uint8_t enabledFrom(uint8_t index) const;
+    /**
+     * @brief Number of leading characters of `filter` contained in the item's text.
+     */
+    uint8_t matchFilter(MenuItem* item);
+    /**
+     * @brief Restore focus after item at `position` was inserted, removed or replaced.
+     * The view is scrolled along when the change happened above it.
+     * @param focused position of the previously focused item after the change
+     * @param position position of the change
+     * @param oldSize number of visible items before the change
+     */
+    void relocate(uint8_t focused, uint8_t position, uint8_t oldSize);
+    /**
+     * @brief Copy the array passed to the constructor, so changes don't touch the caller's array.
+     */
+    void ownItems();
+    /**
+     * @brief Adjust `view` so that the cursor is visible and no rows are left empty needlessly.
+     */
+    void fitView(uint8_t viewSize);
+    /**
+     * @brief Draw rows of the display in range [`from`, `to`).
+     * Display cursor is restored if the focused row was not among them.
+     */
+    void drawRows(MenuRenderer* renderer, uint8_t from, uint8_t to);
+    /**
+     * @brief Redraw after the visible sequence has changed from index `from`.
+     * Only rows which show another item or indicator than before are drawn.
+     * @param oldView view before the change
+     * @param oldSize number of visible items before the change
+     * @param from first changed index in the visible sequence
+     * @param to index after the last changed one, `UINT8_MAX` when everything after `from` shifted
+     */
+    void drawChanged(MenuRenderer* renderer, uint8_t oldView, uint8_t oldSize, uint8_t from, uint8_t to);
+    /**
+     * @brief Insert an item and redraw the rows that shifted.
+     */
+    bool insertItem(MenuRenderer* renderer, uint8_t position, MenuItem* item);
+    /**
+     * @brief Remove an item and redraw the rows that shifted.
+     */
+    MenuItem* removeItem(MenuRenderer* renderer, uint8_t position);
+    /**
+     * @brief Replace an item and redraw its row.
+     */
+    MenuItem* replaceItem(MenuRenderer* renderer, uint8_t position, MenuItem* item);
+    /**
+     * @brief Poll items on the visible rows and redraw the rows whose content changed.
+     * The focused row is also redrawn when the marquee of the renderer advances.
+     * @return true if any row was redrawn
+     */
+    bool poll(MenuRenderer* renderer);
+    /**
+     * @brief Place cursor on an item and choose view so it stays on the preferred row, without redrawing.
+     * @param position the item to focus, the next visible enabled item is used if it can't be focused
+     * @param row preferred row of the display for the focused item
+     */
+    void locate(uint8_t position, uint8_t row);
+    /**
+     * @brief Focus an item after the visible sequence has changed and redraw.
+     * @param position the item to focus, the next visible item is used if it's not visible
+     * @param row preferred row of the display for the focused item
+     */
+    void focus(MenuRenderer* renderer, uint8_t position, uint8_t row);
+    /**
+     * @brief Append character to the filter, without redrawing.
+     * @return `false` if the filter buffer is full
+     */
+    bool pushFilter(const char character);
+    /**
+     * @brief Remove the last character of the filter, without redrawing.
+     */
+    void popFilter();
+    /**
+     * @brief Replace the filter and redraw.
+     * @param filter the new filter, `NULL` or empty string clears it
+     */
+    void setFilter(MenuRenderer* renderer, const char* filter);
+    /**
+     * @brief Append character to the filter and redraw.
+     */
+    bool appendFilter(MenuRenderer* renderer, const unsigned char character);
+    /**
+     * @brief Remove the last character of the filter and redraw.
+     */
+    void removeFilter(MenuRenderer* renderer);
+    /**
+     * @brief Clear the filter, restore the cursor focused before filtering and redraw.
+     */
+    void clearFilter(MenuRenderer* renderer);
     /**
      * @brief Move cursor to specified position.
      */
@@ -124,6 +396,25 @@ class MenuScreen {
      * @brief Reset the screen to initial state.
      */
     void reset(MenuRenderer* renderer);
+    /**
+     * @brief Append character to the type-ahead prefix and jump to the next matching item.
+     * If the previous character was typed more than `TYPE_AHEAD_TIMEOUT` ms ago a new prefix is started.
+     * Typing the same letter repeatedly cycles through the items starting with it.
+     * @return `true` if an item matching the prefix was found.
+     */
+    bool typeAheadSearch(MenuRenderer* renderer, const unsigned char character);
+    /**
+     * @brief Find the next item which text starts with `prefix`.
+     * Uses binary search over `searchIndex`, matches are contiguous there.
+     * @param prefix the prefix to search
+     * @param from the first position to accept, search wraps around to the beginning
+     * @return position of the found item or `itemCount` if nothing matches
+     */
+    uint8_t findByPrefix(const char* prefix, uint8_t from);
+    /**
+     * @brief Build `searchIndex` if it is not yet built.
+     */
+    void buildSearchIndex();
 };
 
 #define MENU_SCREEN(screen, items, ...)         \
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Content of a character display: its cells, cursor and blinker.
+ *
+ * Used to compose a frame in memory and write only the cells which differ
+ * from another frame to the real display.
+ */
+struct CharacterFrame {
+    uint8_t cols = 0;
+    uint8_t rows = 0;
+    /**
+     * @brief Character codes of the cells, row after row.
+     */
+    uint8_t* cells = NULL;
+    uint8_t cursorCol = 0;
+    uint8_t cursorRow = 0;
+    bool blinker = false;
+    bool visible = true;
+    bool backlight = true;
+
+    CharacterFrame() = default;
+    /**
+     * @brief Frames own their cells, use `copyFrom` to copy the content.
+     */
+    CharacterFrame(const CharacterFrame&) = delete;
+    CharacterFrame& operator=(const CharacterFrame&) = delete;
+    ~CharacterFrame() {
+        delete[] cells;
+    }
+
+    /**
+     * @brief Allocate the cells and fill them with blanks.
+     * The cells are reallocated when the frame grows.
+     */
+    void begin(uint8_t cols, uint8_t rows) {
+        if (cells == NULL || cols * rows > this->cols * this->rows) {
+            delete[] cells;
+            cells = new uint8_t[cols * rows];
+        }
+        this->cols = cols;
+        this->rows = rows;
+        clear();
+    }
+    /**
+     * @brief Fill all cells with blanks and move cursor home.
+     */
+    void clear() {
+        memset(cells, ' ', cols * rows);
+        cursorCol = 0;
+        cursorRow = 0;
+    }
+    /**
+     * @brief Write a character at the cursor and advance it, like the display does.
+     * Characters past the end of the row are dropped.
+     */
+    void draw(uint8_t byte) {
+        if (cursorCol < cols && cursorRow < rows) {
+            cells[cursorRow * cols + cursorCol] = byte;
+        }
+        cursorCol++;
+    }
+    /**
+     * @brief Get the character at a cell.
+     */
+    uint8_t at(uint8_t col, uint8_t row) const {
+        return cells[row * cols + col];
+    }
+    /**
+     * @brief Copy content of another frame of the same size.
+     */
+    void copyFrom(const CharacterFrame& other) {
+        memcpy(cells, other.cells, cols * rows);
+        cursorCol = other.cursorCol;
+        cursorRow = other.cursorRow;
+        blinker = other.blinker;
+        visible = other.visible;
+        backlight = other.backlight;
+    }
+};
@@ -22,6 +22,18 @@ class DisplayInterface {
     virtual void draw(const char* text) = 0;
     virtual void setCursor(uint8_t col, uint8_t row) = 0;
     virtual void setBacklight(bool enabled) = 0;
+    /**
+     * @brief Set the brightness of the backlight, displays without dimming only switch it on or off.
+     * @param brightness 0 turns the backlight off, 255 is full brightness
+     */
+    virtual void setBrightness(uint8_t brightness) {
+        setBacklight(brightness != 0);
+    }
+    /**
+     * @brief Called by the menu when a complete frame has been drawn.
+     * Displays which buffer their content, like `FrameBufferDisplay`, publish it here.
+     */
+    virtual void commit() {}
     virtual ~DisplayInterface() {}
 };
 
@@ -0,0 +1,268 @@
+#pragma once
+
+#include "CharacterDisplayInterface.h"
+#include "CharacterFrame.h"
+#include <utils/utils.h>
+
+/**
+ * @class FrameBufferDisplay
+ * @brief Display decorator moving writes to the panel into a separate render task.
+ *
+ * Everything the menu draws is composed into a back frame in memory, which is
+ * cheap and never touches the bus. When the menu finished a frame it calls
+ * `commit`, which publishes a copy of the back frame. The render task calls
+ * `flush`, which takes the latest published frame and writes only the cells
+ * differing from what the panel shows to the wrapped display.
+ *
+ * Publishing and taking a frame happen under the lock, so the render task
+ * never sees a half drawn frame. If a frame is committed before the previous
+ * one was flushed, the previous one is dropped, a slow panel always shows the
+ * latest frame instead of catching up with a backlog.
+ *
+ * ```
+ * menu ──> back ──commit──> ready ──flush──> render ──diff──> panel
+ *                                                     front
+ * ```
+ *
+ * @tparam Lock lock shared by the menu and the render task, must provide
+ *         `lock()` and `unlock()`, e.g. `FreeRTOSLock` or `StdMutexLock`
+ *
+ * @example
+ *   FrameBufferDisplay<FreeRTOSLock> frameBuffer(&lcdAdapter, LCD_COLS, LCD_ROWS);
+ *   CharacterDisplayRenderer renderer(&frameBuffer, LCD_COLS, LCD_ROWS);
+ *   // In the render task
+ *   frameBuffer.flush();
+ */
+template <typename Lock>
+class FrameBufferDisplay : public CharacterDisplayInterface {
+  protected:
+    CharacterDisplayInterface* display;
+    uint8_t cols;
+    uint8_t rows;
+    CharacterFrame frames[4];
+    /**
+     * @brief Frame composed by the menu.
+     */
+    CharacterFrame* back = &frames[0];
+    /**
+     * @brief Latest committed frame, waiting for the render task.
+     */
+    CharacterFrame* ready = &frames[1];
+    /**
+     * @brief Frame being written to the panel by the render task.
+     */
+    CharacterFrame* render = &frames[2];
+    /**
+     * @brief Content of the panel.
+     */
+    CharacterFrame* front = &frames[3];
+    /**
+     * @brief Whether the back frame changed since the last commit.
+     */
+    bool changed = false;
+    bool fresh = false;
+#ifdef DEBUG_LATENCY
+    /**
+     * @brief Start of the input which led to the ready and render frames, see `LATENCY_INPUT_TO_GLASS`.
+     */
+    uint32_t readyInput = 0;
+    uint32_t renderInput = 0;
+#endif
+    uint16_t droppedFrames = 0;
+    /**
+     * @brief Custom characters waiting to be uploaded, one bit per id.
+     */
+    uint8_t pendingGlyphs = 0;
+    uint8_t glyphs[8][8];
+    Lock lock;
+
+  public:
+    /**
+     * @param display the display to render to, only accessed from `flush`
+     * @param cols number of columns of the display
+     * @param rows number of rows of the display
+     */
+    FrameBufferDisplay(CharacterDisplayInterface* display, uint8_t cols, uint8_t rows)
+        : CharacterDisplayInterface(), display(display), cols(cols), rows(rows) {}
+
+    /**
+     * @brief Initialize the wrapped display, call it before starting the render task.
+     */
+    void begin() override {
+        display->begin();
+        for (uint8_t i = 0; i < 4; i++) {
+            frames[i].begin(cols, rows);
+        }
+    }
+
+    void clear() override {
+        back->clear();
+        changed = true;
+    }
+
+    void show() override {
+        back->visible = true;
+        back->backlight = true;
+        changed = true;
+    }
+
+    void hide() override {
+        back->visible = false;
+        back->backlight = false;
+        changed = true;
+    }
+
+    void setBacklight(bool enabled) override {
+        back->backlight = enabled;
+        changed = true;
+    }
+
+    void setCursor(uint8_t col, uint8_t row) override {
+        back->cursorCol = col;
+        back->cursorRow = row;
+        changed = true;
+    }
+
+    void draw(uint8_t byte) override {
+        back->draw(byte);
+        changed = true;
+    }
+
+    void draw(const char* text) override {
+        while (*text) {
+            back->draw(*text++);
+        }
+        changed = true;
+    }
+
+    void drawBlinker() override {
+        back->blinker = true;
+        changed = true;
+    }
+
+    void clearBlinker() override {
+        back->blinker = false;
+        changed = true;
+    }
+
+    void createChar(uint8_t id, uint8_t* c) override {
+        lock.lock();
+        memcpy(glyphs[id & 7], c, 8);
+        bitSet(pendingGlyphs, id & 7);
+        lock.unlock();
+    }
+
+    /**
+     * @brief Publish the back frame for the render task.
+     * A committed frame which was not flushed yet is dropped.
+     */
+    void commit() override {
+        if (!changed) {
+            return;
+        }
+        changed = false;
+        lock.lock();
+        if (fresh) {
+            droppedFrames++;
+        }
+        ready->copyFrom(*back);
+        fresh = true;
+#ifdef DEBUG_LATENCY
+        // Dropped frame passes its older input on to this one
+        uint32_t input = latencyTakeInput();
+        readyInput = readyInput != 0 ? readyInput : input;
+#endif
+        lock.unlock();
+    }
+
+    /**
+     * @brief Write the latest committed frame to the display, call it from the render task.
+     * Only cells which differ from the content of the display are written.
+     * @return true if a new frame was taken
+     */
+    bool flush() {
+        uint8_t glyphMask = 0;
+        uint8_t uploads[8][8];
+        lock.lock();
+        bool taken = fresh;
+        if (taken) {
+            CharacterFrame* swap = ready;
+            ready = render;
+            render = swap;
+            fresh = false;
+#ifdef DEBUG_LATENCY
+            renderInput = readyInput;
+            readyInput = 0;
+#endif
+        }
+        if (pendingGlyphs != 0) {
+            glyphMask = pendingGlyphs;
+            memcpy(uploads, glyphs, sizeof(glyphs));
+            pendingGlyphs = 0;
+        }
+        lock.unlock();
+        for (uint8_t id = 0; id < 8; id++) {
+            if (bitRead(glyphMask, id)) {
+                display->createChar(id, uploads[id]);
+            }
+        }
+        if (glyphMask != 0) {
+            // createChar leaves the address in CGRAM, the next characters would overwrite glyphs
+            display->setCursor(front->cursorCol, front->cursorRow);
+        }
+        if (!taken) {
+            return false;
+        }
+        LATENCY_SCOPE(LATENCY_FLUSH);
+        writeDiff();
+#ifdef DEBUG_LATENCY
+        latencyRecordGlass(renderInput);
+#endif
+        CharacterFrame* swap = front;
+        front = render;
+        render = swap;
+        return true;
+    }
+
+    /**
+     * @brief Number of committed frames which were replaced before the render task took them.
+     */
+    uint16_t getDroppedFrames() const { return droppedFrames; }
+
+  protected:
+    /**
+     * @brief Write the difference between `render` and `front` to the display.
+     */
+    void writeDiff() {
+        bool moved = false;
+        for (uint8_t row = 0; row < rows; row++) {
+            // Display advances its cursor itself while a run of changed cells is written
+            bool inRun = false;
+            for (uint8_t col = 0; col < cols; col++) {
+                uint8_t byte = render->at(col, row);
+                if (byte == front->at(col, row)) {
+                    inRun = false;
+                    continue;
+                }
+                if (!inRun) {
+                    display->setCursor(col, row);
+                    inRun = true;
+                }
+                display->draw(byte);
+                moved = true;
+            }
+        }
+        if (render->visible != front->visible) {
+            render->visible ? display->show() : display->hide();
+        }
+        if (render->backlight != front->backlight || render->visible != front->visible) {
+            display->setBacklight(render->backlight);
+        }
+        if (moved || render->cursorCol != front->cursorCol || render->cursorRow != front->cursorRow) {
+            display->setCursor(render->cursorCol, render->cursorRow);
+        }
+        if (render->blinker != front->blinker) {
+            render->blinker ? display->drawBlinker() : display->clearBlinker();
+        }
+    }
+};
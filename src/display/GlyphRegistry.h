@@ -0,0 +1,171 @@
+#pragma once
+
+#include "CharacterDisplayInterface.h"
+#include <Arduino.h>
+
+/**
+ * @brief Maps custom glyphs to the 8 custom character slots (CGRAM) of a character display.
+ *
+ * A glyph is identified by the address of its 8 byte bitmap. Glyphs used by
+ * the rows currently on the display are pinned, the others stay resident until
+ * their slot is needed, the least recently used one is evicted first.
+ * Bitmaps are only uploaded when they are not resident, and uploads are
+ * collected until `upload` so they are never interleaved with character writes.
+ *
+ * Rows request their glyphs while drawing and report the slots they show at `endRow`:
+ * ```
+ * uint8_t code = glyphs.use(bell);  // slot to draw, 0 if all slots are pinned
+ * ...
+ * glyphs.endRow(row, slots);        // replaces the glyphs previously on this row
+ * glyphs.upload(display);
+ * ```
+ */
+class GlyphRegistry {
+  protected:
+    /**
+     * @brief First managed slot, the slots before are left to the renderer.
+     */
+    const uint8_t firstSlot;
+    const uint8_t rowCount;
+    const uint8_t* glyphs[8] = {};
+    /**
+     * @brief Value of `clock` when a slot was last used, compared by age so it may wrap around.
+     */
+    uint16_t lastUse[8] = {};
+    uint16_t clock = 0;
+    /**
+     * @brief Slots used by each row on the display.
+     */
+    uint8_t* rows;
+    /**
+     * @brief Slots requested for the row being drawn.
+     */
+    uint8_t drawing = 0;
+    /**
+     * @brief Slots with a bitmap which was not uploaded yet.
+     */
+    uint8_t pending = 0;
+
+    uint8_t findSlot(const uint8_t* glyph) const {
+        for (uint8_t slot = firstSlot; slot < 8; slot++) {
+            if (glyphs[slot] == glyph) {
+                return slot;
+            }
+        }
+        return 0;
+    }
+
+    uint8_t pinned() const {
+        uint8_t mask = drawing;
+        for (uint8_t row = 0; row < rowCount; row++) {
+            mask |= rows[row];
+        }
+        return mask;
+    }
+
+  public:
+    /**
+     * @param rowCount number of rows of the display
+     * @param firstSlot first slot managed by the registry, slot 0 can't be drawn as part of a string
+     */
+    GlyphRegistry(uint8_t rowCount, uint8_t firstSlot = 1)
+        : firstSlot(firstSlot > 0 ? firstSlot : 1), rowCount(rowCount), rows(new uint8_t[rowCount]()) {}
+    ~GlyphRegistry() {
+        delete[] rows;
+    }
+    /**
+     * @brief Not copyable, a copy would free `rows` again.
+     */
+    GlyphRegistry(const GlyphRegistry&) = delete;
+    GlyphRegistry& operator=(const GlyphRegistry&) = delete;
+    /**
+     * @brief Get the slot of a glyph for the row being drawn, assigning one if it is not resident.
+     * @param glyph 8 byte bitmap of the glyph, it must stay valid while the glyph is resident
+     * @param changed whether the bitmap changed since it was last used, a resident glyph is uploaded again
+     * @return the slot, to be drawn as a character, or 0 if all slots are pinned by visible rows
+     */
+    uint8_t use(const uint8_t* glyph, bool changed = false) {
+        uint8_t slot = findSlot(glyph);
+        if (slot != 0 && changed) {
+            bitSet(pending, slot);
+        }
+        if (slot == 0) {
+            uint8_t available = ~pinned();
+            uint16_t oldest = 0;
+            for (uint8_t i = firstSlot; i < 8; i++) {
+                if (!bitRead(available, i)) continue;
+                if (glyphs[i] == NULL) {
+                    slot = i;
+                    break;
+                }
+                uint16_t age = clock - lastUse[i];
+                if (slot == 0 || age > oldest) {
+                    slot = i;
+                    oldest = age;
+                }
+            }
+            if (slot == 0) {
+                return 0;
+            }
+            glyphs[slot] = glyph;
+            bitSet(pending, slot);
+        }
+        lastUse[slot] = ++clock;
+        bitSet(drawing, slot);
+        return slot;
+    }
+    /**
+     * @brief Finish a row, its slots replace the ones it showed before.
+     * @param row the row which was drawn
+     * @param slots bit mask of the slots the row shows now, e.g. collected from its cells
+     */
+    void endRow(uint8_t row, uint8_t slots) {
+        if (row < rowCount) {
+            rows[row] = slots;
+        }
+        drawing = 0;
+    }
+    /**
+     * @brief Write the pending bitmaps with `createChar`.
+     * Move the cursor afterwards, the display's address points into CGRAM.
+     * @return true if anything was written
+     */
+    bool upload(CharacterDisplayInterface* display) {
+        if (pending == 0) {
+            return false;
+        }
+        for (uint8_t slot = firstSlot; slot < 8; slot++) {
+            if (bitRead(pending, slot)) {
+                display->createChar(slot, const_cast<uint8_t*>(glyphs[slot]));
+            }
+        }
+        pending = 0;
+        return true;
+    }
+    /**
+     * @brief Forget all glyphs, e.g. after the display was initialized again.
+     */
+    void reset() {
+        memset(glyphs, 0, sizeof(glyphs));
+        memset(rows, 0, rowCount);
+        drawing = 0;
+        pending = 0;
+    }
+    /**
+     * @brief Number of visible rows showing a glyph.
+     */
+    uint8_t getRefCount(const uint8_t* glyph) const {
+        uint8_t slot = findSlot(glyph);
+        uint8_t count = 0;
+        for (uint8_t row = 0; slot != 0 && row < rowCount; row++) {
+            count += bitRead(rows[row], slot);
+        }
+        return count;
+    }
+    /**
+     * @brief Check whether a glyph has a slot, uploaded or pending.
+     */
+    bool isResident(const uint8_t* glyph) const {
+        return findSlot(glyph) != 0;
+    }
+};
@@ -0,0 +1,189 @@
+#pragma once
+
+#include "CharacterDisplayInterface.h"
+#include "CharacterFrame.h"
+
+/**
+ * @brief Character display in memory, for tests and tools which run without hardware.
+ *
+ * It behaves like an HD44780: characters are written at the address counter,
+ * which advances after each of them, and after `createChar` the address points
+ * into the glyph memory until `setCursor`, so characters written in between
+ * change the glyphs instead of the cells.
+ *
+ * `snapshot` prints the content as text, one line per row followed by the
+ * state of the cursor and the glyphs shown in the cells, which `matches`
+ * compares with a stored golden frame:
+ * ```
+ * ~Start service
+ *  Name:         \1
+ * cursor 16,1
+ * glyph 1 04 04 04 04 04 1F 0E 04
+ * ```
+ * Printable characters are shown as they are, glyph codes as `\0` to `\7`,
+ * other codes as `\xFF` and `\` as `\\`. Trailing blanks are kept. The
+ * cursor line ends with `blink` when the blinker is drawn, and with `hidden`
+ * or `dark` when the display or the backlight is off.
+ */
+class HeadlessDisplay : public CharacterDisplayInterface {
+  protected:
+    CharacterFrame frame;
+    uint8_t glyphs[8][8] = {};
+    /**
+     * @brief Address in the glyph memory, or -1 when the address points to the cells.
+     */
+    int8_t glyphAddress = -1;
+
+    /**
+     * @brief Compares printed text with a golden frame without keeping it.
+     */
+    class Comparator : public Print {
+      public:
+        const char* expected;
+        bool equal = true;
+        explicit Comparator(const char* expected) : expected(expected) {}
+        size_t write(uint8_t byte) override {
+            if (*expected != (char)byte) {
+                equal = false;
+            } else {
+                expected++;
+            }
+            return 1;
+        }
+    };
+
+    static void printHex(Print& out, uint8_t value) {
+        const char* digits = "0123456789ABCDEF";
+        out.print(digits[value >> 4]);
+        out.print(digits[value & 0x0F]);
+    }
+
+  public:
+    HeadlessDisplay(uint8_t cols, uint8_t rows) {
+        frame.begin(cols, rows);
+    }
+
+    void begin() override {
+        frame.clear();
+        frame.blinker = false;
+        frame.visible = true;
+        frame.backlight = true;
+        glyphAddress = -1;
+    }
+    void clear() override {
+        frame.clear();
+        glyphAddress = -1;
+    }
+    void show() override {
+        frame.visible = true;
+    }
+    void hide() override {
+        frame.visible = false;
+    }
+    void draw(uint8_t byte) override {
+        if (glyphAddress >= 0) {
+            glyphs[glyphAddress >> 3][glyphAddress & 7] = byte & 0x1F;
+            glyphAddress = (glyphAddress + 1) & 0x3F;
+            return;
+        }
+        frame.draw(byte);
+    }
+    void draw(const char* text) override {
+        while (*text != '\0') {
+            draw(*text++);
+        }
+    }
+    void setCursor(uint8_t col, uint8_t row) override {
+        frame.cursorCol = col;
+        frame.cursorRow = row;
+        glyphAddress = -1;
+    }
+    void setBacklight(bool enabled) override {
+        frame.backlight = enabled;
+    }
+    void createChar(uint8_t id, uint8_t* c) override {
+        id &= 7;
+        memcpy(glyphs[id], c, 8);
+        // The address is left after the written glyph
+        glyphAddress = ((id + 1) << 3) & 0x3F;
+    }
+    void drawBlinker() override {
+        frame.blinker = true;
+    }
+    void clearBlinker() override {
+        frame.blinker = false;
+    }
+
+    /**
+     * @brief Get the content of the cells, cursor and blinker.
+     */
+    const CharacterFrame& getFrame() const {
+        return frame;
+    }
+    /**
+     * @brief Get the 8 byte bitmap of a glyph.
+     */
+    const uint8_t* getGlyph(uint8_t id) const {
+        return glyphs[id & 7];
+    }
+    /**
+     * @brief Print the content as text, see the format above.
+     */
+    void snapshot(Print& out) const {
+        uint8_t used = 0;
+        for (uint8_t row = 0; row < frame.rows; row++) {
+            for (uint8_t col = 0; col < frame.cols; col++) {
+                uint8_t cell = frame.at(col, row);
+                if (cell < 8) {
+                    bitSet(used, cell);
+                    out.print('\\');
+                    out.print((char)('0' + cell));
+                } else if (cell < 0x20 || cell >= 0x7F) {
+                    out.print(F("\\x"));
+                    printHex(out, cell);
+                } else if (cell == '\\') {
+                    out.print(F("\\\\"));
+                } else {
+                    out.print((char)cell);
+                }
+            }
+            out.print('\n');
+        }
+        out.print(F("cursor "));
+        out.print(frame.cursorCol);
+        out.print(',');
+        out.print(frame.cursorRow);
+        out.print(frame.blinker ? F(" blink") : F(""));
+        out.print(frame.visible ? F("") : F(" hidden"));
+        out.print(frame.backlight ? F("") : F(" dark"));
+        out.print('\n');
+        for (uint8_t id = 0; id < 8; id++) {
+            if (!bitRead(used, id)) continue;
+            out.print(F("glyph "));
+            out.print((char)('0' + id));
+            for (uint8_t i = 0; i < 8; i++) {
+                out.print(' ');
+                printHex(out, glyphs[id][i]);
+            }
+            out.print('\n');
+        }
+    }
+    /**
+     * @brief Compare the content with a golden frame.
+     * @param golden the expected snapshot
+     * @param out where to print the expected and the actual snapshot if they differ, `NULL` to print nothing
+     * @return true if the snapshot equals `golden`
+     */
+    bool matches(const char* golden, Print* out = NULL) const {
+        Comparator comparator(golden);
+        snapshot(comparator);
+        bool equal = comparator.equal && *comparator.expected == '\0';
+        if (!equal && out != NULL) {
+            out->print(F("Expected:\n"));
+            out->print(golden);
+            out->print(F("Actual:\n"));
+            snapshot(*out);
+        }
+        return equal;
+    }
+};
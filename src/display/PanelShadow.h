@@ -0,0 +1,68 @@
+#pragma once
+
+#include "GlyphRegistry.h"
+#include <Arduino.h>
+
+class MenuRenderer;
+
+/**
+ * @brief Shadow of a character display shared by the renderers drawing to parts of it.
+ *
+ * Every renderer with a viewport on the display keeps its cells in the shared
+ * shadow instead of its own, so the custom character slots are assigned for the
+ * whole display and the rows of side by side viewports pin the glyphs of both.
+ * The display is initialized by the first renderer to begin, the others keep
+ * what it shows. The cursor of the display goes back to the renderer showing the
+ * blinker after another one drew.
+ *
+ * ```
+ * PanelShadow panel(20, 4);
+ * statusRenderer.setViewport(0, 0, 20, 2, &panel);
+ * menuRenderer.setViewport(0, 2, 20, 2, &panel);
+ * ```
+ */
+class PanelShadow {
+    friend class CharacterDisplayRenderer;
+
+  protected:
+    const uint8_t cols;
+    const uint8_t rows;
+    /**
+     * @brief Content of every cell as last written, `cols` bytes per row.
+     */
+    uint8_t* cells;
+    /**
+     * @brief Slots of the custom glyphs of all viewports, one registry row per row of the display.
+     */
+    GlyphRegistry glyphs;
+    /**
+     * @brief Whether a renderer initialized the display already.
+     */
+    bool begun = false;
+    /**
+     * @brief Renderer showing the blinker, `NULL` if none does.
+     */
+    const MenuRenderer* blinker = NULL;
+    uint8_t blinkerCol = 0;
+    uint8_t blinkerRow = 0;
+
+  public:
+    /**
+     * @param cols number of columns of the display
+     * @param rows number of rows of the display
+     * @param firstSlot first custom character slot assigned to glyphs, slots 0 and 1 hold the arrows by default
+     */
+    PanelShadow(uint8_t cols, uint8_t rows, uint8_t firstSlot = 2)
+        : cols(cols), rows(rows), cells(new uint8_t[cols * rows]()), glyphs(rows, firstSlot) {}
+    ~PanelShadow() { delete[] cells; }
+    /**
+     * @brief Forget the display was initialized, the next renderer to begin initializes it again.
+     */
+    void reset() {
+        begun = false;
+        blinker = NULL;
+        glyphs.reset();
+    }
+    uint8_t getCols() const { return cols; }
+    uint8_t getRows() const { return rows; }
+};
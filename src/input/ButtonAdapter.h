@@ -32,8 +32,9 @@ class ButtonAdapter : public InputInterface {
         : InputInterface(menu), button(button), command(command) {}
 
     void observe() override {
+        LATENCY_OBSERVE_SCOPE();
         if (button->pressed()) {
-            menu->process(command);
+            process(command);
         }
     }
 };
\ No newline at end of file
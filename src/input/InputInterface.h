@@ -15,13 +15,64 @@
  * @param menu Pointer to an LcdMenu object that this input interface will interact with.
  */
 class InputInterface {
+    friend class LcdMenu;
+
+  private:
+    /**
+     * @brief Next adapter of the same menu, see `LcdMenu::getIdleState`.
+     */
+    InputInterface* nextInput = NULL;
+    const uint8_t* wakePins = NULL;
+    uint8_t wakePinCount = 0;
+
   protected:
     LcdMenu* menu = NULL;
 
+    /**
+     * @brief Pass a command read from the input to the menu.
+     * @return true if the command was handled
+     */
+    bool process(const unsigned char command) {
+        LATENCY_COMMAND();
+        return menu->process(command);
+    }
+
   public:
-    InputInterface(LcdMenu* menu) : menu(menu) {}
+    InputInterface(LcdMenu* menu) : menu(menu) {
+        if (menu != NULL) {
+            menu->addInput(this);
+        }
+    }
 
-    virtual ~InputInterface() = default;
+    virtual ~InputInterface() {
+        if (menu != NULL) {
+            menu->removeInput(this);
+        }
+    }
 
     virtual void observe() = 0;
+    /**
+     * @brief Check whether input arrived which `observe` didn't handle yet, e.g. bytes in a stream buffer.
+     * The menu doesn't sleep while any adapter has pending input.
+     */
+    virtual bool hasPendingInput() { return false; }
+    /**
+     * @brief Set the pins which change when the adapter gets input, e.g. the pins of its buttons.
+     * They are reported by `LcdMenu::getWakePins` to attach (pin change) interrupts waking the MCU.
+     * @param pins the pins, must stay valid
+     * @param count number of pins
+     */
+    void setWakePins(const uint8_t* pins, uint8_t count) {
+        wakePins = pins;
+        wakePinCount = count;
+    }
+    /**
+     * @brief Get the pins which wake the MCU for this adapter.
+     * @param pins set to the pins
+     * @return number of pins
+     */
+    uint8_t getWakePins(const uint8_t*& pins) const {
+        pins = wakePins;
+        return wakePinCount;
+    }
 };
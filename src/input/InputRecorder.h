@@ -0,0 +1,99 @@
+#pragma once
+
+#include "InputInterface.h"
+#include "utils/InputRecord.h"
+
+/**
+ * @class InputRecorder
+ * @brief Records every command reaching `LcdMenu::process`, with its time, while observing another adapter.
+ *
+ * Use it in place of the wrapped adapter. Commands are recorded at
+ * `LcdMenu::process`, so commands sent by timers, e.g. the ENTER of a single
+ * `\r` on a `KeyboardAdapter`, are recorded as well. The records can be
+ * played back with `InputReplay` or used as a workload of `WcetBenchmark`.
+ * See `InputRecord.h` for the format.
+ *
+ * @example
+ *   KeyboardAdapter keyboard(&menu, &Serial);
+ *   InputRecorder recorder(&menu, &keyboard, &recording);
+ *   void loop() { recorder.observe(); }
+ */
+class InputRecorder : public InputInterface, public InputObserver {
+  protected:
+    InputInterface* input;
+    Print* out;
+    uint32_t lastTime = 0;
+    uint16_t count = 0;
+    bool recording = false;
+    bool full = false;
+
+  public:
+    /**
+     * @param menu the menu, the recorder is set as its `InputObserver`
+     * @param input the adapter to observe, `NULL` to only record commands sent by other means
+     * @param out where to write the records
+     */
+    InputRecorder(LcdMenu* menu, InputInterface* input, Print* out)
+        : InputInterface(menu), input(input), out(out) {
+        start();
+    }
+    ~InputRecorder() {
+        if (menu != NULL && menu->getInputObserver() == this) {
+            menu->setInputObserver(NULL);
+        }
+    }
+    void observe() override {
+        if (input != NULL) {
+            input->observe();
+        }
+    }
+    bool hasPendingInput() override {
+        return input != NULL && input->hasPendingInput();
+    }
+    void onInput(const unsigned char command) override {
+        if (!recording) {
+            return;
+        }
+        uint32_t now = menuMillis();
+        if (writeInputRecord(*out, now - lastTime, command) == 0) {
+            // Don't record past a gap
+            full = true;
+            recording = false;
+            return;
+        }
+        lastTime = now;
+        count++;
+    }
+    /**
+     * @brief Start recording, the first record is timed from now.
+     */
+    void start() {
+        lastTime = menuMillis();
+        recording = true;
+        full = false;
+        if (menu != NULL) {
+            menu->setInputObserver(this);
+        }
+    }
+    /**
+     * @brief Stop recording, e.g. while the recording is played back.
+     */
+    void stop() {
+        recording = false;
+    }
+    bool isRecording() const {
+        return recording;
+    }
+    /**
+     * @brief Check whether recording stopped because `out` was full.
+     */
+    bool isFull() const {
+        return full;
+    }
+    /**
+     * @brief Number of recorded commands.
+     */
+    uint16_t getCount() const {
+        return count;
+    }
+};
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "InputInterface.h"
+#include "utils/InputRecord.h"
+
+/**
+ * @class InputReplay
+ * @brief Plays back commands recorded by `InputRecorder`, at their original or an accelerated pace.
+ *
+ * Commands are sent from `observe` and from `LcdMenu::poll` when they are due,
+ * so the menu can sleep between them. The pace is kept from command to
+ * command, a late command doesn't delay the following ones.
+ *
+ * @example
+ *   InputReplay replay(&menu, &recording, 4);  // Four times faster
+ *   void setup() { replay.start(); }
+ *   void loop() {
+ *       replay.observe();
+ *       menu.poll();
+ *   }
+ */
+class InputReplay : public InputInterface {
+  protected:
+    Stream* in;
+    InputRecordReader reader;
+    BoundTimer<InputReplay> timer{this, &InputReplay::onTimer};
+    /**
+     * @brief Speed up factor, 0 sends all commands without waiting.
+     */
+    uint8_t speed;
+    /**
+     * @brief Time the previous command was due.
+     */
+    uint32_t lastTime = 0;
+    bool loaded = false;
+    bool playing = false;
+
+    void onTimer(uint32_t now) {
+        update(now);
+    }
+    /**
+     * @brief Send all commands which are due.
+     */
+    void update(uint32_t now) {
+        while (playing) {
+            if (!loaded) {
+                loaded = reader.read(*in);
+                if (!loaded) {
+                    return;
+                }
+            }
+            uint32_t due = lastTime + (speed != 0 ? reader.delta / speed : 0);
+            if ((int32_t)(now - due) < 0) {
+                menu->getTimers()->schedule(&timer, due);
+                return;
+            }
+            loaded = false;
+            lastTime = due;
+            menu->process(reader.command);
+        }
+    }
+
+  public:
+    /**
+     * @param menu the menu to send the commands to
+     * @param in the recording
+     * @param speed speed up factor, 1 is the original pace, 0 sends all commands without waiting
+     */
+    InputReplay(LcdMenu* menu, Stream* in, uint8_t speed = 1)
+        : InputInterface(menu), in(in), speed(speed) {}
+    ~InputReplay() {
+        if (menu != NULL) {
+            menu->getTimers()->cancel(&timer);
+        }
+    }
+    void observe() override {
+        update(menuMillis());
+    }
+    bool hasPendingInput() override {
+        return playing && !loaded && in->available() > 0;
+    }
+    /**
+     * @brief Start playing from the current position of the stream, the next command is timed from now.
+     * Commands without delay are sent right away.
+     */
+    void start() {
+        lastTime = menuMillis();
+        playing = true;
+        update(lastTime);
+    }
+    /**
+     * @brief Stop playing, the next `start` continues where it stopped.
+     */
+    void stop() {
+        playing = false;
+        if (menu != NULL) {
+            menu->getTimers()->cancel(&timer);
+        }
+    }
+    void setSpeed(uint8_t speed) {
+        this->speed = speed;
+    }
+    /**
+     * @brief Check whether all recorded commands were sent.
+     */
+    bool isDone() const {
+        return !loaded && in->available() == 0;
+    }
+    bool isPlaying() const {
+        return playing;
+    }
+};
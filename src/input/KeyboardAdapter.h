@@ -102,7 +102,7 @@ class KeyboardAdapter : public InputInterface {
      * @brief Milliseconds timestamp of last received character.
      * Used for detecting ESC with no chars next or single `\r` without `\n`.
      */
-    unsigned long lastCharTimestamp;
+    uint32_t lastCharTimestamp;
     /**
      * @brief Buffer to store already read values of "intermediate bytes".
      * Multiple bytes command for CSI is in form of `ESC [ <intermediate bytes> <terminal byte>`.
@@ -112,6 +112,11 @@ class KeyboardAdapter : public InputInterface {
      * @brief Points to next available byte in `csiBuffer`.
      */
     uint8_t csiBufferCursor = 0;
+    /**
+     * @brief Fires `THRESHOLD` ms after the last character from `LcdMenu::poll`,
+     * so a single `\r` or `ESC` is handled without calling `observe`.
+     */
+    BoundTimer<KeyboardAdapter> idleTimer{this, &KeyboardAdapter::onIdle};
     /**
      * @brief Reset to initial state.
      */
@@ -120,14 +125,23 @@ class KeyboardAdapter : public InputInterface {
         csiBufferCursor = 0;
         lastChar = 0;
         lastCharTimestamp = 0;
+        if (menu != NULL) {
+            menu->getTimers()->cancel(&idleTimer);
+        }
     }
     inline bool hasLastChar() {
-        // TODO: Check millis() overflow situation
-        return lastChar != 0 && millis() > lastCharTimestamp + THRESHOLD;
+        return lastChar != 0 && menuMillis() - lastCharTimestamp >= THRESHOLD;
     }
     inline void saveLastChar(unsigned char command) {
         lastChar = command;
-        lastCharTimestamp = millis();
+        lastCharTimestamp = menuMillis();
+        menu->getTimers()->schedule(&idleTimer, lastCharTimestamp + THRESHOLD);
+    }
+    void onIdle(uint32_t now) {
+        if (lastChar != 0) {
+            handleIdle();
+            reset();
+        }
     }
     /**
      * @brief Handle idle state when there are no input for some time.
@@ -137,11 +151,11 @@ class KeyboardAdapter : public InputInterface {
         switch (lastChar) {
             case CR:  // Received single `\r`
                 // LOG(F("Call ENTER from idle"));
-                menu->process(ENTER);
+                process(ENTER);
                 break;
             case ESC:  // Received single `ESC`
                 // LOG(F("Call BACK from idle"));
-                menu->process(BACK);
+                process(BACK);
                 break;
         }
     }
@@ -155,10 +169,10 @@ class KeyboardAdapter : public InputInterface {
                 switch (command) {
                     case BS:   // 8. On Win
                     case DEL:  // 127. On Mac
-                        menu->process(BACKSPACE);
+                        process(BACKSPACE);
                         break;
                     case LF:  // 10, \n
-                        menu->process(ENTER);
+                        process(ENTER);
                         break;
                     case CR:  // 13, \r
                         // Can be \r\n sequence, do nothing
@@ -167,7 +181,7 @@ class KeyboardAdapter : public InputInterface {
                         codeSet = CodeSet::C1;
                         break;
                     default:
-                        menu->process(command);
+                        process(command);
                         break;
                 }
                 saveLastChar(command);
@@ -186,16 +200,16 @@ class KeyboardAdapter : public InputInterface {
                 if (command >= C2_CSI_TERMINAL_MIN && command <= C2_CSI_TERMINAL_MAX) {
                     switch (command) {
                         case 'A':
-                            menu->process(UP);
+                            process(UP);
                             break;
                         case 'B':
-                            menu->process(DOWN);
+                            process(DOWN);
                             break;
                         case 'C':
-                            menu->process(RIGHT);
+                            process(RIGHT);
                             break;
                         case 'D':
-                            menu->process(LEFT);
+                            process(LEFT);
                             break;
                         case 'F':
                             LOG(F("End"));
@@ -210,7 +224,7 @@ class KeyboardAdapter : public InputInterface {
                                         LOG(F("Insert"));
                                         break;
                                     case 3:  // Delete
-                                        menu->process(CLEAR);
+                                        process(CLEAR);
                                         break;
                                     case 5:  // PgUp
                                         LOG(F("PgUp"));
@@ -237,7 +251,16 @@ class KeyboardAdapter : public InputInterface {
     KeyboardAdapter(LcdMenu* menu, Stream* stream)
         : InputInterface(menu), stream(stream) {
     }
+    ~KeyboardAdapter() {
+        if (menu != NULL) {
+            menu->getTimers()->cancel(&idleTimer);
+        }
+    }
+    bool hasPendingInput() override {
+        return stream->available() > 0;
+    }
     void observe() override {
+        LATENCY_OBSERVE_SCOPE();
         if (!stream->available()) {
             if (hasLastChar()) {
                 handleIdle();
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "InputInterface.h"
+#include "Stream.h"
+#include "renderer/RemoteRenderer.h"
+#include "utils/RemoteFrame.h"
+
+/**
+ * @class RemoteAdapter
+ * @brief Reads frames of the remote protocol from a stream, so a PC or another MCU can drive the menu.
+ *
+ * `REMOTE_INPUT` frames are passed to `LcdMenu::process` command by command
+ * and answered with the number of processed commands, after the changes they
+ * caused. `REMOTE_READ` and `REMOTE_SUBSCRIBE` are answered by the
+ * `RemoteRenderer`, subscribing sends the whole screen first so the changes
+ * apply to a known state. Frames with a wrong CRC are dropped, the remote
+ * sends them again when the answer doesn't come. See `RemoteFrame.h` for the
+ * format.
+ *
+ * @example
+ *   RemoteRenderer renderer(&Serial, 16, 2);
+ *   LcdMenu menu(renderer);
+ *   RemoteAdapter remote(&menu, &Serial, &renderer);
+ *   void loop() {
+ *       remote.observe();
+ *       menu.poll();
+ *   }
+ */
+class RemoteAdapter : public InputInterface {
+  protected:
+    Stream* stream;
+    RemoteRenderer* renderer;
+    RemoteFrameReader reader;
+
+    void acknowledge(uint8_t type, uint8_t value) {
+        RemoteFrameWriter frame(*stream, REMOTE_ACK, 2);
+        frame.write(type);
+        frame.write(value);
+        frame.end();
+    }
+
+    void handle() {
+        switch (reader.type) {
+            case REMOTE_INPUT: {
+                uint8_t processed = 0;
+                for (uint8_t i = 0; i < reader.length; i++) {
+                    processed += menu->process(reader.payload[i]) ? 1 : 0;
+                }
+                acknowledge(REMOTE_INPUT, processed);
+                break;
+            }
+            case REMOTE_READ:
+                renderer->sendScreen();
+                break;
+            case REMOTE_SUBSCRIBE: {
+                bool subscribe = reader.length > 0 && reader.payload[0] != 0;
+                if (subscribe) {
+                    renderer->sendScreen();
+                }
+                renderer->setSubscribed(subscribe);
+                acknowledge(REMOTE_SUBSCRIBE, 1);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+  public:
+    /**
+     * @param menu the menu to drive
+     * @param stream stream to read the frames from and to write the answers to
+     * @param renderer renderer sending the screen, the renderer of the menu or a target of its `MirrorRenderer`
+     */
+    RemoteAdapter(LcdMenu* menu, Stream* stream, RemoteRenderer* renderer)
+        : InputInterface(menu), stream(stream), renderer(renderer) {}
+
+    void observe() override {
+        while (reader.read(*stream)) {
+            handle();
+        }
+    }
+    bool hasPendingInput() override {
+        return stream->available() > 0;
+    }
+    /**
+     * @brief Number of frames dropped because of a wrong CRC or length.
+     */
+    uint16_t getErrors() const {
+        return reader.getErrors();
+    }
+};
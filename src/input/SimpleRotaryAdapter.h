@@ -47,47 +47,66 @@
  */
 class SimpleRotaryAdapter : public InputInterface {
   private:
-    unsigned long lastPressTime = 0;  // Last time the button was pressed
+    uint32_t lastPressTime = 0;       // Last time the button was pressed
     bool pendingEnter = false;        // Flag to indicate if an enter action is pending
     SimpleRotary* encoder;            // Pointer to the SimpleRotary instance
+    // Fires the pending enter from `LcdMenu::poll` once the double press threshold passed
+    BoundTimer<SimpleRotaryAdapter> enterTimer{this, &SimpleRotaryAdapter::onEnter};
+
+    void onEnter(uint32_t now) {
+        if (pendingEnter) {
+            process(ENTER);
+            pendingEnter = false;
+        }
+    }
 
   public:
     SimpleRotaryAdapter(LcdMenu* menu, SimpleRotary* encoder)
         : InputInterface(menu), encoder(encoder) {
     }
+    ~SimpleRotaryAdapter() {
+        if (menu != NULL) {
+            menu->getTimers()->cancel(&enterTimer);
+        }
+    }
 
     void observe() override {
+        LATENCY_OBSERVE_SCOPE();
         // Handle rotary encoder rotation
         uint8_t rotation = encoder->rotate();
         if (rotation == 1) {
-            menu->process(DOWN);  // Call DOWN action
+            process(DOWN);  // Call DOWN action
         } else if (rotation == 2) {
-            menu->process(UP);  // Call UP action
+            process(UP);  // Call UP action
         }
 
         // Handle button press (short, long, and double press)
         uint8_t pressType = encoder->pushType(LONG_PRESS_DURATION);
-        unsigned long currentTime = millis();
+        uint32_t currentTime = menuMillis();
 
         if (pressType == 1) {
             if (pendingEnter) {
                 if (DOUBLE_PRESS_THRESHOLD > 0 && currentTime - lastPressTime < DOUBLE_PRESS_THRESHOLD) {
-                    menu->process(BACKSPACE);  // Call BACKSPACE action (double press)
+                    process(BACKSPACE);  // Call BACKSPACE action (double press)
                     pendingEnter = false;
                 }
             } else {
                 pendingEnter = true;
                 lastPressTime = currentTime;
+                menu->getTimers()->schedule(&enterTimer, lastPressTime + DOUBLE_PRESS_THRESHOLD);
             }
         } else if (pressType == 2) {
-            menu->process(BACK);  // Call BACK action (long press)
+            process(BACK);  // Call BACK action (long press)
             pendingEnter = false;
         }
 
         // Check if the doublePressThreshold has elapsed for pending enter action
         if ((!menu->getRenderer()->isInEditMode() && pendingEnter) || (pendingEnter && (currentTime - lastPressTime >= DOUBLE_PRESS_THRESHOLD))) {
-            menu->process(ENTER);  // Call ENTER action (short press)
+            process(ENTER);  // Call ENTER action (short press)
             pendingEnter = false;
         }
+        if (!pendingEnter) {
+            menu->getTimers()->cancel(&enterTimer);
+        }
     }
 };
\ No newline at end of file
@@ -0,0 +1,310 @@
+#include "AnsiRenderer.h"
+
+void AnsiTerminal::begin() {
+    // Reset attributes, hide the cursor and don't wrap at the end of a row
+    renderer->stream->print(F("\x1B[0m\x1B[?25l\x1B[?7l"));
+}
+
+void AnsiTerminal::clear() {
+    renderer->clearTerminal();
+}
+
+void AnsiTerminal::show() {
+    if (!renderer->hidden) {
+        return;
+    }
+    renderer->hidden = false;
+    renderer->repaint();
+}
+
+void AnsiTerminal::hide() {
+    if (renderer->hidden) {
+        return;
+    }
+    renderer->stream->print(F("\x1B[0m\x1B[?25l\x1B[2J"));
+    renderer->terminalAttribute = AnsiRenderer::NORMAL;
+    renderer->terminalCol = UINT8_MAX;
+    renderer->hidden = true;
+}
+
+void AnsiTerminal::draw(uint8_t byte) {
+    renderer->draw(byte);
+}
+
+void AnsiTerminal::draw(const char* text) {
+    while (*text != '\0') {
+        renderer->draw(*text++);
+    }
+}
+
+void AnsiTerminal::commit() {
+    // Drawing moved the terminal cursor, the blinker goes back to the cursor of the menu
+    if (renderer->blinker && !renderer->hidden) {
+        renderer->moveTo(renderer->cursorCol, renderer->cursorRow, renderer->terminalAttribute);
+    }
+}
+
+void AnsiTerminal::setCursor(uint8_t col, uint8_t row) {
+    renderer->drawCol = col;
+    renderer->drawRow = row;
+}
+
+AnsiRenderer::AnsiRenderer(
+    Stream* stream,
+    uint8_t maxCols,
+    uint8_t maxRows,
+    const char* upArrow,
+    const char* downArrow,
+    const char* rail)
+    : MenuRenderer(&terminal, maxCols, maxRows),
+      stream(stream),
+      upArrow(upArrow),
+      downArrow(downArrow),
+      rail(rail),
+      capacityCols(maxCols),
+      capacityRows(maxRows),
+      shadow(new uint8_t[maxCols * maxRows]),
+      rowAttributes(new uint8_t[maxRows]) {}
+
+AnsiRenderer::~AnsiRenderer() {
+    delete[] shadow;
+    delete[] rowAttributes;
+}
+
+void AnsiRenderer::begin() {
+    MenuRenderer::begin();
+    hidden = false;
+    blinker = false;
+    uint8_t cols;
+    uint8_t rows;
+    if (detectSize(cols, rows)) {
+        maxCols = min(cols, capacityCols);
+        maxRows = min(rows, capacityRows);
+    }
+    clearTerminal();
+}
+
+bool AnsiRenderer::detectSize(uint8_t& cols, uint8_t& rows) {
+    // The cursor stops at the bottom right corner, its position is the size
+    stream->print(F("\x1B[999;999H\x1B[6n"));
+    terminalCol = UINT8_MAX;
+    // Answer is ESC [ rows ; cols R
+    uint16_t values[2] = {0, 0};
+    uint8_t field = 0;
+    bool inAnswer = false;
+    uint32_t start = menuMillis();
+    while ((uint32_t)(menuMillis() - start) < ANSI_SIZE_TIMEOUT) {
+        if (stream->available() <= 0) {
+            continue;
+        }
+        int c = stream->read();
+        if (c == 0x1B) {
+            inAnswer = true;
+            field = 0;
+            values[0] = values[1] = 0;
+        } else if (!inAnswer || c == '[') {
+            continue;
+        } else if (c >= '0' && c <= '9' && values[field] < 1000) {
+            values[field] = values[field] * 10 + (c - '0');
+        } else if (c == ';' && field == 0) {
+            field = 1;
+        } else if (c == 'R' && field == 1 && values[0] > 0 && values[1] > 0) {
+            rows = min(values[0], (uint16_t)UINT8_MAX);
+            cols = min(values[1], (uint16_t)UINT8_MAX);
+            return true;
+        } else {
+            inAnswer = false;
+        }
+    }
+    return false;
+}
+
+void AnsiRenderer::clearTerminal() {
+    memset(shadow, ' ', maxCols * maxRows);
+    memset(rowAttributes, NORMAL, maxRows);
+    if (hidden) {
+        return;
+    }
+    stream->print(F("\x1B[0m\x1B[2J"));
+    terminalAttribute = NORMAL;
+    terminalCol = UINT8_MAX;
+    updateBlinker();
+}
+
+void AnsiRenderer::repaint() {
+    uint8_t textCols = upArrow != NULL ? maxCols - 1 : maxCols;
+    for (uint8_t row = 0; row < maxRows; row++) {
+        uint8_t attribute = rowAttributes[row] != UNKNOWN ? rowAttributes[row] : NORMAL;
+        for (uint8_t col = 0; col < maxCols; col++) {
+            moveTo(col, row, attribute);
+            writeCell(shadow[row * maxCols + col], col < textCols ? attribute : NORMAL);
+        }
+        rowAttributes[row] = attribute;
+    }
+    updateBlinker();
+}
+
+void AnsiRenderer::drawItem(const char* text, const char* value, bool paddWithBlanks) {
+    LATENCY_SCOPE(LATENCY_DRAW_ITEM);
+    uint8_t row = cursorRow;
+    if (row >= maxRows) {
+        return;
+    }
+    uint8_t attribute = hasFocus ? (inEditMode ? EDIT : FOCUS) : NORMAL;
+    bool known = rowAttributes[row] == attribute;
+    uint8_t textCols = getEffectiveCols();
+    uint8_t col = 0;
+
+    // Focused row may be scrolled by the marquee
+    uint8_t shift = viewShift;
+    if (hasFocus) {
+        uint8_t length = strlen(text) + (value ? strlen(value) + 1 : 0);
+        shift += getMarqueeShift(text, length > textCols ? length - textCols : 0);
+    }
+
+    drawText(text, col, shift, attribute, known);
+    if (value && col < textCols && (!hasFocus || shift < strlen(text) + 1)) {
+        putCell(col++, row, ':', attribute, known);
+    }
+    if (value) {
+        uint8_t textLen = strlen(text);
+        drawText(value, col, shift > textLen ? shift - textLen - 1 : 0, attribute, known);
+    }
+    uint8_t end = col;
+
+    // Reverse video covers the whole row up to the indicator
+    if (paddWithBlanks) {
+        for (; col < textCols; col++) {
+            putCell(col, row, ' ', attribute, known);
+        }
+    }
+    if (upArrow != NULL) {
+        uint8_t indicator = hasHiddenItemsAbove ? INDICATOR_UP : (hasHiddenItemsBelow ? INDICATOR_DOWN : INDICATOR_RAIL);
+        putCell(maxCols - 1, row, indicator, NORMAL, rowAttributes[row] != UNKNOWN);
+    }
+
+    // Cells not drawn keep the previous attribute
+    rowAttributes[row] = paddWithBlanks || known ? attribute : UNKNOWN;
+
+    if (hasFocus) moveCursor(end, row);
+}
+
+void AnsiRenderer::drawText(const char* text, uint8_t& col, uint8_t shift, uint8_t attribute, bool known) {
+    const char* textPtr = text;
+    if (hasFocus) {
+        textPtr = shift < strlen(text) ? textPtr + shift : NULL;
+    }
+    uint8_t textCols = getEffectiveCols();
+    while (col < textCols && textPtr && *textPtr) {
+        putCell(col, cursorRow, printable(*textPtr++), attribute, known);
+        col++;
+    }
+}
+
+void AnsiRenderer::putCell(uint8_t col, uint8_t row, uint8_t byte, uint8_t attribute, bool known) {
+    uint8_t& cell = shadow[row * maxCols + col];
+    if (known && cell == byte) {
+        return;
+    }
+    cell = byte;
+    if (hidden) {
+        return;
+    }
+    moveTo(col, row, attribute);
+    writeCell(byte, attribute);
+}
+
+void AnsiRenderer::writeCell(uint8_t byte, uint8_t attribute) {
+    setAttribute(attribute);
+    if (byte == INDICATOR_UP || byte == INDICATOR_DOWN || byte == INDICATOR_RAIL) {
+        stream->print(byte == INDICATOR_UP ? upArrow : (byte == INDICATOR_DOWN ? downArrow : rail));
+    } else if (byte == WIDGET_BAR_FULL) {
+        stream->print(F("\xE2\x96\x88"));
+    } else {
+        stream->write(byte);
+    }
+    // The cursor stays on the last column, whether the terminal is wider or not
+    terminalCol = terminalCol + 1 < maxCols ? terminalCol + 1 : UINT8_MAX;
+}
+
+uint8_t AnsiRenderer::printable(uint8_t byte) {
+    return (byte >= 0x20 && byte < 0x7F) || byte == WIDGET_BAR_FULL ? byte : '?';
+}
+
+void AnsiRenderer::moveTo(uint8_t col, uint8_t row, uint8_t attribute) {
+    if (terminalCol == col && terminalRow == row) {
+        return;
+    }
+    // Rewriting a few cells of the same attribute is shorter than positioning the cursor
+    uint8_t textCols = getEffectiveCols();
+    if (terminalRow == row && terminalCol < col && col - terminalCol <= 3 && col <= textCols &&
+        terminalAttribute == attribute && rowAttributes[row] == attribute) {
+        while (terminalCol < col) {
+            writeCell(shadow[row * maxCols + terminalCol], attribute);
+        }
+        return;
+    }
+    stream->print(F("\x1B["));
+    stream->print(row + 1);
+    stream->print(';');
+    stream->print(col + 1);
+    stream->print('H');
+    terminalCol = col;
+    terminalRow = row;
+}
+
+void AnsiRenderer::setAttribute(uint8_t attribute) {
+    if (attribute == terminalAttribute) {
+        return;
+    }
+    stream->print(attribute == EDIT ? F("\x1B[0;4;7m") : (attribute == FOCUS ? F("\x1B[0;7m") : F("\x1B[0m")));
+    terminalAttribute = attribute;
+}
+
+void AnsiRenderer::updateBlinker() {
+    if (hidden) {
+        return;
+    }
+    if (blinker) {
+        moveTo(cursorCol, cursorRow, terminalAttribute);
+        stream->print(F("\x1B[?25h"));
+    } else {
+        stream->print(F("\x1B[?25l"));
+    }
+}
+
+void AnsiRenderer::draw(uint8_t byte) {
+    if (drawRow < maxRows && drawCol < maxCols) {
+        uint8_t attribute = rowAttributes[drawRow] != UNKNOWN ? rowAttributes[drawRow] : NORMAL;
+        putCell(drawCol, drawRow, printable(byte), attribute, false);
+    }
+    drawCol++;
+}
+
+void AnsiRenderer::invalidate() {
+    memset(rowAttributes, UNKNOWN, maxRows);
+}
+
+void AnsiRenderer::drawBlinker() {
+    if (!blinker) {
+        blinker = true;
+        updateBlinker();
+    }
+}
+
+void AnsiRenderer::clearBlinker() {
+    if (blinker) {
+        blinker = false;
+        updateBlinker();
+    }
+}
+
+void AnsiRenderer::moveCursor(uint8_t cursorCol, uint8_t cursorRow) {
+    MenuRenderer::moveCursor(cursorCol, cursorRow);
+    drawCol = cursorCol;
+    drawRow = cursorRow;
+}
+
+uint8_t AnsiRenderer::getEffectiveCols() const {
+    return upArrow != NULL ? maxCols - 1 : maxCols;
+}
@@ -0,0 +1,200 @@
+#pragma once
+
+#include "MenuRenderer.h"
+
+class AnsiRenderer;
+
+/**
+ * @brief Display of `AnsiRenderer`, it forwards what the menu does to the display to the renderer.
+ */
+class AnsiTerminal : public DisplayInterface {
+  protected:
+    AnsiRenderer* renderer;
+
+  public:
+    explicit AnsiTerminal(AnsiRenderer* renderer) : renderer(renderer) {}
+    void begin() override;
+    void clear() override;
+    void show() override;
+    void hide() override;
+    void draw(uint8_t byte) override;
+    void draw(const char* text) override;
+    void setCursor(uint8_t col, uint8_t row) override;
+    /**
+     * @brief Move the terminal cursor back to the blinker once the menu drew a frame.
+     */
+    void commit() override;
+    /**
+     * @brief Terminals have no backlight, the power stages before `DisplayPower::OFF` do nothing.
+     */
+    void setBacklight(bool enabled) override {}
+};
+
+/**
+ * @class AnsiRenderer
+ * @brief Renders the menu with ANSI/VT100 escape sequences to a `Stream`, e.g. a serial console.
+ *
+ * The focused row is shown in reverse video and underlined in edit mode, the
+ * terminal cursor is the blinker and is placed when the menu commits a frame.
+ * The column on the right shows a rail with heavy ends when there are items
+ * above or below the view.
+ *
+ * The renderer remembers every cell of the terminal, only changed cells are
+ * written and the cursor is only positioned when they are not adjacent, which
+ * keeps a redraw after a move of the cursor to a few dozen bytes.
+ *
+ * `begin` asks the terminal for its size and uses it, up to the size the
+ * renderer was created with. Terminals which don't answer within
+ * `ANSI_SIZE_TIMEOUT` get the size the renderer was created with. The answer is
+ * read from the stream, keys typed while `begin` waits are dropped.
+ *
+ * `DisplayPower::OFF` clears the terminal and shows the menu again on wake up.
+ * Bytes which are not printable ASCII are written as `?`, except
+ * `WIDGET_BAR_FULL` which is written as a full block.
+ *
+ * @example
+ *   AnsiRenderer renderer(&Serial, 80, 24);
+ *   LcdMenu menu(renderer);
+ *   KeyboardAdapter keyboard(&menu, &Serial);
+ */
+class AnsiRenderer : public MenuRenderer {
+    friend class AnsiTerminal;
+
+  protected:
+    /**
+     * @brief How a cell is shown, selected with SGR sequences.
+     */
+    enum Attribute : uint8_t {
+        NORMAL,
+        FOCUS,
+        EDIT,
+        /**
+         * @brief Marks a row whose cells are not known.
+         */
+        UNKNOWN = 0xFF,
+    };
+    /**
+     * @brief Cell codes of the scroll indicators, written as `upArrow`, `downArrow` and `rail`.
+     */
+    enum Indicator : uint8_t {
+        INDICATOR_UP,
+        INDICATOR_DOWN,
+        INDICATOR_RAIL,
+    };
+
+    AnsiTerminal terminal{this};
+    Stream* stream;
+    const char* upArrow;
+    const char* downArrow;
+    const char* rail;
+    /**
+     * @brief Size the renderer was created with, `maxCols` and `maxRows` are never larger.
+     */
+    const uint8_t capacityCols;
+    const uint8_t capacityRows;
+    /**
+     * @brief Content of every cell, `maxCols` bytes per row.
+     */
+    uint8_t* shadow;
+    /**
+     * @brief Attribute of the text cells of every row, the indicator is always `NORMAL`.
+     */
+    uint8_t* rowAttributes;
+    /**
+     * @brief Position of the terminal cursor, `UINT8_MAX` if unknown.
+     */
+    uint8_t terminalCol = UINT8_MAX;
+    uint8_t terminalRow = UINT8_MAX;
+    /**
+     * @brief Attribute the terminal writes with, `UNKNOWN` if unknown.
+     */
+    uint8_t terminalAttribute = UNKNOWN;
+    /**
+     * @brief Cell written by `draw`, set by `moveCursor` and `setCursor` of the display.
+     */
+    uint8_t drawCol = 0;
+    uint8_t drawRow = 0;
+    bool blinker = false;
+    /**
+     * @brief Whether the terminal was cleared by `DisplayPower::OFF`, cells are only remembered then.
+     */
+    bool hidden = false;
+
+    /**
+     * @brief Ask the terminal for its size and wait for the answer.
+     * @return true if the terminal answered
+     */
+    bool detectSize(uint8_t& cols, uint8_t& rows);
+    /**
+     * @brief Clear the terminal and remember blank cells.
+     */
+    void clearTerminal();
+    /**
+     * @brief Write all remembered cells, e.g. after the terminal was cleared.
+     */
+    void repaint();
+    /**
+     * @brief Write a cell if it changed or its row is not known.
+     */
+    void putCell(uint8_t col, uint8_t row, uint8_t byte, uint8_t attribute, bool known);
+    /**
+     * @brief Write a remembered cell at the terminal cursor.
+     */
+    void writeCell(uint8_t byte, uint8_t attribute);
+    /**
+     * @brief Move the terminal cursor, by rewriting up to 3 cells of the row if that is shorter.
+     */
+    void moveTo(uint8_t col, uint8_t row, uint8_t attribute);
+    void setAttribute(uint8_t attribute);
+    /**
+     * @brief Replace a byte which can't be written by `?`, the cell codes of the indicators included.
+     */
+    static uint8_t printable(uint8_t byte);
+    /**
+     * @brief Show or hide the terminal cursor at the position of the menu cursor.
+     */
+    void updateBlinker();
+    /**
+     * @brief Draw text from a column of the current row.
+     */
+    void drawText(const char* text, uint8_t& col, uint8_t shift, uint8_t attribute, bool known);
+    uint8_t getEffectiveCols() const override;
+
+  public:
+    /**
+     * @param stream the terminal
+     * @param maxCols largest number of columns used, a smaller terminal reported in `begin` uses less
+     * @param maxRows largest number of rows used, a smaller terminal reported in `begin` uses less
+     * @param upArrow UTF-8 text shown when there are items above the view, default is ╿, if NULL no indicators are shown
+     * @param downArrow UTF-8 text shown when there are items below the view, default is ╽
+     * @param rail UTF-8 text shown in the other rows, default is │
+     */
+    AnsiRenderer(
+        Stream* stream,
+        uint8_t maxCols,
+        uint8_t maxRows,
+        const char* upArrow = "\xE2\x95\xBF",
+        const char* downArrow = "\xE2\x95\xBD",
+        const char* rail = "\xE2\x94\x82");
+    ~AnsiRenderer();
+
+    /**
+     * @brief Reset the terminal, detect its size and clear it.
+     */
+    void begin() override;
+    /**
+     * @brief Draws a menu item, only the cells which changed are written.
+     */
+    void drawItem(const char* text, const char* value, bool paddWithBlanks = true) override;
+    /**
+     * @brief Draw a byte at the cursor of the menu and advance it.
+     */
+    void draw(uint8_t byte) override;
+    /**
+     * @brief Forget what is shown on the terminal, the next draw of every row writes all of its cells.
+     */
+    void invalidate() override;
+    void drawBlinker() override;
+    void clearBlinker() override;
+    void moveCursor(uint8_t cursorCol, uint8_t cursorRow) override;
+};
@@ -13,37 +13,83 @@ CharacterDisplayRenderer::CharacterDisplayRenderer(
       downArrow(downArrow),
       cursorIcon(cursorIcon),
       editCursorIcon(editCursorIcon),
-      availableColumns(maxCols - (upArrow != NULL || downArrow != NULL ? 1 : 0)) {}
+      availableColumns(maxCols - (upArrow != NULL || downArrow != NULL ? 1 : 0)),
+      capacityCols(maxCols),
+      capacityRows(maxRows),
+      glyphs(maxRows, upArrow != NULL || downArrow != NULL ? 2 : 1),
+      shadow(new uint8_t[maxCols * maxRows]()) {}
+
+CharacterDisplayRenderer::~CharacterDisplayRenderer() {
+    delete[] shadow;
+}
 
 void CharacterDisplayRenderer::begin() {
-    MenuRenderer::begin();
-    static_cast<CharacterDisplayInterface*>(display)->createChar(0, upArrow);
-    static_cast<CharacterDisplayInterface*>(display)->createChar(1, downArrow);
+    invalidate();
+    if (panel != NULL && panel->begun) {
+        // Initializing the display again would clear the other viewports
+        restartTimer();
+    } else {
+        MenuRenderer::begin();
+        getGlyphs().reset();
+    }
+    if (upArrow != NULL) {
+        static_cast<CharacterDisplayInterface*>(display)->createChar(0, upArrow);
+    }
+    if (downArrow != NULL) {
+        static_cast<CharacterDisplayInterface*>(display)->createChar(1, downArrow);
+    }
+    if (panel != NULL) {
+        panel->begun = true;
+    }
+}
+
+void CharacterDisplayRenderer::setViewport(uint8_t col, uint8_t row, uint8_t cols, uint8_t rows) {
+    setViewport(col, row, cols, rows, panel);
+}
+
+void CharacterDisplayRenderer::setViewport(uint8_t col, uint8_t row, uint8_t cols, uint8_t rows, PanelShadow* panel) {
+    this->panel = panel;
+    if (panel == NULL) {
+        cols = min(cols, capacityCols);
+        rows = min(rows, capacityRows);
+    }
+    MenuRenderer::setViewport(col, row, cols, rows);
+    availableColumns = maxCols - (upArrow != NULL || downArrow != NULL ? 1 : 0);
+    invalidate();
 }
 
 void CharacterDisplayRenderer::drawItem(const char* text, const char* value, bool paddWithBlanks) {
+    LATENCY_SCOPE(LATENCY_DRAW_ITEM);
     uint8_t cursorCol = 0;
-    display->setCursor(cursorCol, cursorRow);
+    nextCol = UINT8_MAX;
+
+    // Focused row may be scrolled by the marquee
+    uint8_t shift = viewShift;
+    if (hasFocus) {
+        uint8_t length = strlen(text) + (value ? strlen(value) + 1 : 0);
+        uint8_t room = getEffectiveCols();
+        shift += getMarqueeShift(text, length > room ? length - room : 0);
+    }
 
     // Draw cursor or empty space based on focus and edit mode
     if (cursorIcon != 0 || editCursorIcon != 0) {
-        display->draw(hasFocus ? (inEditMode ? editCursorIcon : cursorIcon) : ' ');
+        drawCell(cursorCol, hasFocus ? (inEditMode ? editCursorIcon : cursorIcon) : ' ');
         cursorCol++;
     }
 
     // Draw text
-    drawText(text, cursorCol, viewShift);
+    drawText(text, cursorCol, shift);
 
     // Draw colon separator if value is present and within bounds
-    if (value && cursorCol < availableColumns && (!hasFocus || viewShift < strlen(text) + 1)) {
-        display->draw(':');
+    if (value && cursorCol < availableColumns && (!hasFocus || shift < strlen(text) + 1)) {
+        drawCell(cursorCol, ':');
         cursorCol++;
     }
 
     // Draw value if present
     if (value) {
         uint8_t textLen = strlen(text);
-        uint8_t valueViewShift = (viewShift > textLen) ? viewShift - textLen - 1 : 0;
+        uint8_t valueViewShift = (shift > textLen) ? shift - textLen - 1 : 0;
         drawText(value, cursorCol, valueViewShift);
     }
 
@@ -52,19 +98,39 @@ void CharacterDisplayRenderer::drawItem(const char* text, const char* value, boo
     // Fill remaining space with whitespace only when paddWithBlanks is true
     if (paddWithBlanks) {
         for (; cursorCol < availableColumns; cursorCol++) {
-            display->draw(' ');
+            drawCell(cursorCol, ' ');
         }
     }
 
     // Draw up and down arrows if present
     if (upArrow && downArrow) {
         uint8_t indicator = hasHiddenItemsAbove ? 0 : (hasHiddenItemsBelow ? 1 : ' ');
-        display->setCursor(maxCols - 1, cursorRow);
-        display->draw(indicator);
+        drawCell(maxCols - 1, indicator);
     }
 
+    // Cells not drawn are only known if the row was complete before
+    if (paddWithBlanks && cursorRow < 8) {
+        bitSet(validRows, cursorRow);
+    }
+
+    endRow(cursorColEnd);
+
     // Move cursor to the end position if focused
-    if (hasFocus) moveCursor(cursorColEnd, cursorRow);
+    if (hasFocus) {
+        moveCursor(cursorColEnd, cursorRow);
+    } else {
+        restoreBlinker();
+    }
+}
+
+void CharacterDisplayRenderer::endRow(uint8_t col) {
+    // Rows of the shared registry are the rows of the display
+    GlyphRegistry& registry = getGlyphs();
+    registry.endRow(panel != NULL ? originRow + cursorRow : cursorRow, getRowGlyphs(cursorRow));
+    // Upload new glyphs after the row, createChar leaves the address in CGRAM
+    if (registry.upload(static_cast<CharacterDisplayInterface*>(display))) {
+        display->setCursor(originCol + col, originRow + cursorRow);
+    }
 }
 
 void CharacterDisplayRenderer::drawText(const char* text, uint8_t& col, uint8_t shift) {
@@ -80,26 +146,122 @@ void CharacterDisplayRenderer::drawText(const char* text, uint8_t& col, uint8_t
 
     // Draw characters from the text until we reach the end of the available columns or the end of the text
     while (col < availableColumns && textPtr && *textPtr) {
-        display->draw(*textPtr++);  // Draw the current character and move to the next
+        drawCell(col, *textPtr++);  // Draw the current character and move to the next
         col++;                      // Move to the next column
     }
 }
 
+uint8_t CharacterDisplayRenderer::glyph(const uint8_t* glyph, uint8_t fallback, bool changed) {
+    uint8_t slot = getGlyphs().use(glyph, changed);
+    return slot != 0 ? slot : fallback;
+}
+
+void CharacterDisplayRenderer::drawCell(uint8_t col, uint8_t byte) {
+    uint8_t& cell = getShadowRow(cursorRow)[col];
+    if (cursorRow < 8 && bitRead(validRows, cursorRow) && cell == byte) {
+        return;
+    }
+    // Skipped cells leave the address behind
+    if (col != nextCol) {
+        display->setCursor(originCol + col, originRow + cursorRow);
+    }
+    display->draw(byte);
+    cell = byte;
+    nextCol = col + 1;
+}
+
+uint8_t CharacterDisplayRenderer::getRowGlyphs(uint8_t row) const {
+    // Viewports side by side share the row of the display, it shows the glyphs of all of them
+    const uint8_t* cells = panel != NULL ? getShadowRow(row) - originCol : getShadowRow(row);
+    uint8_t cols = panel != NULL ? panel->cols : maxCols;
+    uint8_t slots = 0;
+    for (uint8_t col = 0; col < cols; col++) {
+        if (cells[col] < 8) {
+            bitSet(slots, cells[col]);
+        }
+    }
+    return slots;
+}
+
+uint8_t* CharacterDisplayRenderer::getShadowRow(uint8_t row) const {
+    if (panel != NULL) {
+        return panel->cells + (originRow + row) * panel->cols + originCol;
+    }
+    return shadow + row * capacityCols;
+}
+
+void CharacterDisplayRenderer::clear() {
+    if (panel == NULL && originCol == 0 && originRow == 0 && maxCols == capacityCols && maxRows == capacityRows) {
+        display->clear();
+        return;
+    }
+    // Only the cells of the viewport are blanked, the others keep what they show
+    uint8_t row = cursorRow;
+    for (cursorRow = 0; cursorRow < maxRows; cursorRow++) {
+        nextCol = UINT8_MAX;
+        for (uint8_t col = 0; col < maxCols; col++) {
+            drawCell(col, ' ');
+        }
+        if (cursorRow < 8) {
+            bitSet(validRows, cursorRow);
+        }
+        endRow(0);
+    }
+    cursorRow = row;
+    restoreBlinker();
+}
+
+void CharacterDisplayRenderer::restoreBlinker() {
+    if (panel != NULL && panel->blinker != NULL && panel->blinker != this) {
+        display->setCursor(panel->blinkerCol, panel->blinkerRow);
+    }
+}
+
+void CharacterDisplayRenderer::invalidate() {
+    validRows = 0;
+}
+
 void CharacterDisplayRenderer::draw(uint8_t byte) {
+    // Written at the address of the display, the row isn't known cell by cell anymore
+    if (cursorRow < 8) {
+        bitClear(validRows, cursorRow);
+    }
+    // Another viewport may have moved the address since the cursor was set
+    if (panel != NULL) {
+        display->setCursor(originCol + cursorCol, originRow + cursorRow);
+    }
     display->draw(byte);
+    restoreBlinker();
 }
 
 void CharacterDisplayRenderer::drawBlinker() {
+    if (panel != NULL) {
+        panel->blinker = this;
+        panel->blinkerCol = originCol + cursorCol;
+        panel->blinkerRow = originRow + cursorRow;
+    }
     static_cast<CharacterDisplayInterface*>(display)->drawBlinker();
 }
 
 void CharacterDisplayRenderer::clearBlinker() {
+    if (panel != NULL) {
+        // The blinker of another viewport stays
+        if (panel->blinker != this && panel->blinker != NULL) {
+            return;
+        }
+        panel->blinker = NULL;
+    }
     static_cast<CharacterDisplayInterface*>(display)->clearBlinker();
 }
 
 void CharacterDisplayRenderer::moveCursor(uint8_t cursorCol, uint8_t cursorRow) {
     MenuRenderer::moveCursor(cursorCol, cursorRow);
-    display->setCursor(cursorCol, cursorRow);
+    display->setCursor(originCol + cursorCol, originRow + cursorRow);
+    if (panel != NULL && panel->blinker == this) {
+        panel->blinkerCol = originCol + cursorCol;
+        panel->blinkerRow = originRow + cursorRow;
+    }
+    restoreBlinker();
 }
 
 uint8_t CharacterDisplayRenderer::getEffectiveCols() const {
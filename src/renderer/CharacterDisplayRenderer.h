@@ -2,6 +2,8 @@
 
 #include "MenuRenderer.h"
 #include "display/CharacterDisplayInterface.h"
+#include "display/GlyphRegistry.h"
+#include "display/PanelShadow.h"
 
 /**
  * @class CharacterDisplayRenderer
@@ -16,6 +18,10 @@
  * the CharacterDisplayInterface. It provides methods to draw menu items, cursors, and
  * navigation indicators. The class also handles text truncation and cursor movement.
  *
+ * With `setViewport` the renderer draws into a part of the display. Renderers
+ * whose viewports share a display share a `PanelShadow` too, each one then only
+ * writes and clears its own cells and never makes the others draw again.
+ *
  * @note
  * The class uses dynamic memory allocation for the upArrow and downArrow icons.
  */
@@ -25,7 +31,32 @@ class CharacterDisplayRenderer : public MenuRenderer {
     uint8_t* downArrow;
     const uint8_t cursorIcon;
     const uint8_t editCursorIcon;
-    const uint8_t availableColumns;
+    uint8_t availableColumns;
+    /**
+     * @brief Size given to the constructor, the own shadow is allocated for it.
+     */
+    const uint8_t capacityCols;
+    const uint8_t capacityRows;
+    /**
+     * @brief Slots of the custom glyphs requested with `glyph`, unless the shadow is shared.
+     */
+    GlyphRegistry glyphs;
+    /**
+     * @brief Content of every cell as last written, `capacityCols` bytes per row, unless the shadow is shared.
+     */
+    uint8_t* shadow;
+    /**
+     * @brief Shadow shared with the other viewports on the display, `NULL` if the renderer has its own.
+     */
+    PanelShadow* panel = NULL;
+    /**
+     * @brief Rows whose cells are all known from `shadow`, only these skip unchanged cells.
+     */
+    uint8_t validRows = 0;
+    /**
+     * @brief Column the display writes to next on the current row, `UINT8_MAX` if unknown.
+     */
+    uint8_t nextCol = UINT8_MAX;
     /**
      * @brief Calculates the available horizontal space for displaying content.
      *
@@ -49,6 +80,30 @@ class CharacterDisplayRenderer : public MenuRenderer {
      * @param viewShift The number of columns to shift the text by.
      */
     inline void drawText(const char* text, uint8_t& col, uint8_t viewShift);
+    /**
+     * @brief Draws a byte at a column of the current row, unless the cell already shows it.
+     */
+    void drawCell(uint8_t col, uint8_t byte);
+    /**
+     * @brief Gets the custom character slots shown on a row.
+     */
+    uint8_t getRowGlyphs(uint8_t row) const;
+    /**
+     * @brief Gets the first cell of a row of the viewport in the own or the shared shadow.
+     */
+    uint8_t* getShadowRow(uint8_t row) const;
+    /**
+     * @brief Gets the registry assigning the custom character slots, the shared one if there is a panel.
+     */
+    GlyphRegistry& getGlyphs() { return panel != NULL ? panel->glyphs : glyphs; }
+    /**
+     * @brief Finish a drawn row, uploading its new glyphs.
+     */
+    void endRow(uint8_t col);
+    /**
+     * @brief Put the cursor of the display back to the renderer showing the blinker, if it's another one.
+     */
+    void restoreBlinker();
 
   public:
     /**
@@ -57,7 +112,8 @@ class CharacterDisplayRenderer : public MenuRenderer {
      *        Also sets the up and down arrow icons, cursor icons, and edit cursor icons.
      *
      * @note slots 0 and 1 are reserved for up and down arrow icons.
-     *       The available custom characters slots are 2 to 7.
+     *       Slots 2 to 7 (1 to 7 without arrows) are assigned on demand to the glyphs requested
+     *       with `glyph`, don't create characters in them if any item uses glyphs.
      *
      * @param display A pointer to the CharacterDisplayInterface object.
      * @param maxCols The maximum number of columns on the display.
@@ -75,6 +131,7 @@ class CharacterDisplayRenderer : public MenuRenderer {
         const uint8_t editCursorIcon = 0x7F,
         uint8_t* upArrow = new uint8_t[8]{0x04, 0x0E, 0x1F, 0x04, 0x04, 0x04, 0x04, 0x04},
         uint8_t* downArrow = new uint8_t[8]{0x04, 0x04, 0x04, 0x04, 0x04, 0x1F, 0x0E, 0x04});
+    ~CharacterDisplayRenderer();
 
     /**
      * @brief Initializes the renderer and creates custom characters on the display.
@@ -91,9 +148,34 @@ class CharacterDisplayRenderer : public MenuRenderer {
      * @param text The text of the menu item to be drawn.
      * @param value The value of the menu item to be drawn.
      * @param paddWithBlanks A flag indicating whether to pad the text with spaces.
+     *
+     * @note Cells which already show the right character are not written again.
      */
     void drawItem(const char* text, const char* value, bool paddWithBlanks) override;
+    /**
+     * @brief Get the slot of a custom glyph, uploading it with the row if it is not resident.
+     * @return the slot, or `fallback` if all slots are used by visible rows
+     */
+    uint8_t glyph(const uint8_t* glyph, uint8_t fallback, bool changed = false) override;
+    /**
+     * @brief Set the part of the display to draw into, keeping the shadow.
+     */
+    void setViewport(uint8_t col, uint8_t row, uint8_t cols, uint8_t rows) override;
+    /**
+     * @brief Set the part of the display to draw into.
+     * @param panel shadow shared with the renderers of the other viewports on the display, `NULL` to use the own one
+     * @note Without a panel the viewport can't be larger than the size given to the constructor.
+     */
+    void setViewport(uint8_t col, uint8_t row, uint8_t cols, uint8_t rows, PanelShadow* panel);
+    /**
+     * @brief Clear the display, or write blanks to the cells of the viewport if the renderer has one.
+     */
+    void clear() override;
+    /**
+     * @brief Draws a byte at the cursor.
+     */
     void draw(uint8_t byte) override;
+    void invalidate() override;
     void drawBlinker() override;
     void clearBlinker() override;
     void moveCursor(uint8_t cursorCol, uint8_t cursorRow) override;
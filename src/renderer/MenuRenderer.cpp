@@ -5,7 +5,17 @@ MenuRenderer::MenuRenderer(DisplayInterface* display, uint8_t maxCols, uint8_t m
 
 void MenuRenderer::begin() {
     display->begin();
-    startTime = millis();
+    startTime = menuMillis();
+    power = DisplayPower::ON;
+    dimmed = false;
+    schedulePower();
+}
+
+void MenuRenderer::setViewport(uint8_t col, uint8_t row, uint8_t cols, uint8_t rows) {
+    originCol = col;
+    originRow = row;
+    maxCols = cols;
+    maxRows = rows;
 }
 
 void MenuRenderer::moveCursor(uint8_t cursorCol, uint8_t cursorRow) {
@@ -20,9 +30,147 @@ void MenuRenderer::setEditMode(bool inEditMode) {
     }
 }
 
+void MenuRenderer::setTimers(TimerWheel* timers) {
+    cancel(&displayTimer);
+    cancel(&marqueeTimer);
+    this->timers = timers;
+    schedulePower();
+}
+
+void MenuRenderer::setTimeout(unsigned long timeout) {
+    setPowerTimeouts(0, 0, timeout);
+}
+
+void MenuRenderer::setPowerTimeouts(unsigned long dim, unsigned long backlightOff, unsigned long displayOff) {
+    powerTimeouts[0] = dim;
+    powerTimeouts[1] = backlightOff;
+    powerTimeouts[2] = displayOff;
+    schedulePower();
+}
+
+void MenuRenderer::schedulePower() {
+    unsigned long next = 0;
+    for (uint8_t stage = (uint8_t)power; stage < 3; stage++) {
+        unsigned long timeout = powerTimeouts[stage];
+        if (timeout != 0 && (next == 0 || timeout < next)) {
+            next = timeout;
+        }
+    }
+    if (next != 0) {
+        schedule(&displayTimer, startTime + next);
+    } else {
+        cancel(&displayTimer);
+    }
+}
+
+void MenuRenderer::updatePower(uint32_t now) {
+    uint32_t elapsed = now - startTime;
+    DisplayPower state = power;
+    for (uint8_t stage = (uint8_t)power; stage < 3; stage++) {
+        if (powerTimeouts[stage] != 0 && elapsed >= powerTimeouts[stage]) {
+            state = (DisplayPower)(stage + 1);
+        }
+    }
+    setPower(state);
+    schedulePower();
+}
+
+void MenuRenderer::setPower(DisplayPower state) {
+    if (state == power) {
+        return;
+    }
+    if (state == DisplayPower::ON) {
+        if (power == DisplayPower::OFF) {
+            display->show();
+        }
+        if (dimmed) {
+            display->setBrightness(255);
+            dimmed = false;
+        }
+    } else if (state == DisplayPower::OFF) {
+        LOG(F("MenuRenderer::timeout"));
+        display->hide();
+    } else {
+        display->setBrightness(state == DisplayPower::DIM ? DISPLAY_DIM_BRIGHTNESS : 0);
+        dimmed = true;
+    }
+    power = state;
+    display->commit();
+}
+
+void MenuRenderer::schedule(MenuTimer* timer, uint32_t deadline) {
+    if (timers != NULL) {
+        timers->schedule(timer, deadline);
+    }
+}
+
 void MenuRenderer::restartTimer() {
-    this->startTime = millis();
-    display->show();
+    this->startTime = menuMillis();
+    setPower(DisplayPower::ON);
+    schedulePower();
+}
+
+void MenuRenderer::updateTimer() {
+    if (powerTimeouts[0] != 0 || powerTimeouts[1] != 0 || powerTimeouts[2] != 0) {
+        updatePower(menuMillis());
+    } else if (power != DisplayPower::OFF && menuMillis() - startTime >= DISPLAY_TIMEOUT) {
+        setPower(DisplayPower::OFF);
+    }
+}
+
+void MenuRenderer::cancel(MenuTimer* timer) {
+    if (timers != NULL) {
+        timers->cancel(timer);
+    }
+}
+
+void MenuRenderer::setMarquee(uint16_t interval, uint16_t pause) {
+    marqueeInterval = interval;
+    marqueePause = pause;
+    marqueeShift = 0;
+    marqueeText = NULL;
+    cancel(&marqueeTimer);
+}
+
+uint8_t MenuRenderer::getMarqueeShift(const char* text, uint8_t overflow) {
+    // Edit mode owns the view, start over when it ends
+    if (marqueeInterval == 0 || inEditMode) {
+        marqueeText = NULL;
+        cancel(&marqueeTimer);
+        return 0;
+    }
+    if (text != marqueeText) {
+        marqueeText = text;
+        marqueeShift = 0;
+        marqueeTime = menuMillis();
+        cancel(&marqueeTimer);
+    }
+    marqueeOverflow = overflow;
+    if (marqueeShift > overflow) {
+        marqueeShift = overflow;
+    }
+    if (overflow == 0) {
+        cancel(&marqueeTimer);
+    } else if (!marqueeTimer.isArmed()) {
+        schedule(&marqueeTimer, marqueeTime + getMarqueeWait());
+    }
+    return viewShift == 0 ? marqueeShift : 0;
+}
+
+void MenuRenderer::marqueeDue(uint32_t now) {
+    if (marqueeText == NULL || inEditMode || viewShift != 0 || marqueeOverflow == 0) {
+        return;
+    }
+    marqueeTime = now;
+    marqueeShift = marqueeShift < marqueeOverflow ? marqueeShift + 1 : 0;
+    marqueeStepped = true;
+    schedule(&marqueeTimer, now + getMarqueeWait());
+}
+
+bool MenuRenderer::takeMarqueeStep() {
+    bool stepped = marqueeStepped;
+    marqueeStepped = false;
+    return stepped;
 }
 
 bool MenuRenderer::isInEditMode() const { return inEditMode; }
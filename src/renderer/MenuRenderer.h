@@ -2,9 +2,27 @@
 #define MENU_RENDERER_H
 
 #include "display/DisplayInterface.h"
+#include "utils/TimerWheel.h"
 #include <Arduino.h>
 #include <utils/utils.h>
 
+/**
+ * @brief Power stages of the display, entered in this order while there is no input.
+ * @see MenuRenderer::setPowerTimeouts
+ */
+enum class DisplayPower : uint8_t {
+    ON,
+    /**
+     * @brief Backlight dimmed to `DISPLAY_DIM_BRIGHTNESS`.
+     */
+    DIM,
+    BACKLIGHT_OFF,
+    /**
+     * @brief Display hidden, the content is kept and shown again on wake up.
+     */
+    OFF,
+};
+
 /**
  * @class MenuRenderer
  * @brief Abstract base class for rendering a menu on a display.
@@ -15,10 +33,19 @@
  */
 class MenuRenderer {
     friend class MenuScreen;
+    friend class MirrorRenderer;
 
   protected:
-    const uint8_t maxCols;
-    const uint8_t maxRows;
+    /**
+     * @brief Size of the display, fixed unless the renderer detects it in `begin`.
+     */
+    uint8_t maxCols;
+    uint8_t maxRows;
+    /**
+     * @brief Column and row of the display the renderer draws its first cell at, see `setViewport`.
+     */
+    uint8_t originCol = 0;
+    uint8_t originRow = 0;
 
     /**
      * @brief Flag indicating that there are hidden items above the current view.
@@ -34,12 +61,100 @@ class MenuRenderer {
      */
     bool hasFocus = false;
 
-    uint8_t cursorCol;
-    uint8_t cursorRow;
+    uint8_t cursorCol = 0;
+    uint8_t cursorRow = 0;
 
-    bool inEditMode;
+    bool inEditMode = false;
 
-    unsigned long startTime = 0;
+    uint32_t startTime = 0;
+    /**
+     * @brief Time in milliseconds without input after which each stage after `DisplayPower::ON` is entered, 0 skips it.
+     */
+    unsigned long powerTimeouts[3] = {};
+    /**
+     * @brief Current power stage, commands are only sent to the display when it changes.
+     */
+    DisplayPower power = DisplayPower::ON;
+    /**
+     * @brief Flag indicating that the brightness was changed by a stage, it is restored on wake up.
+     */
+    bool dimmed = false;
+    /**
+     * @brief Wheel the timers of the renderer are scheduled on, set by `LcdMenu`.
+     */
+    TimerWheel* timers = NULL;
+    BoundTimer<MenuRenderer> displayTimer{this, &MenuRenderer::updatePower};
+    BoundTimer<MenuRenderer> marqueeTimer{this, &MenuRenderer::marqueeDue};
+
+    /**
+     * @brief Time in milliseconds between two marquee steps, 0 disables the marquee.
+     */
+    uint16_t marqueeInterval = 0;
+    /**
+     * @brief Time in milliseconds the marquee waits at both ends.
+     */
+    uint16_t marqueePause = 0;
+    /**
+     * @brief Number of columns the focused row is scrolled by the marquee.
+     */
+    uint8_t marqueeShift = 0;
+    /**
+     * @brief Number of columns the focused row is longer than the display.
+     */
+    uint8_t marqueeOverflow = 0;
+    /**
+     * @brief Text of the focused item, another text restarts the marquee.
+     */
+    const char* marqueeText = NULL;
+    uint32_t marqueeTime = 0;
+    /**
+     * @brief Whether the marquee advanced since the focused row was drawn, see `takeMarqueeStep`.
+     */
+    bool marqueeStepped = false;
+
+    /**
+     * @brief Get the marquee shift of the focused row, call it when drawing the focused row.
+     * Outside of edit mode and without a manual `viewShift` the row is scrolled by the marquee.
+     * @param text text of the focused item
+     * @param overflow number of columns the row is longer than the display
+     * @return the number of columns to shift the row by, in addition to `viewShift`
+     */
+    uint8_t getMarqueeShift(const char* text, uint8_t overflow);
+    /**
+     * @brief Check whether the marquee advanced since the last call, the focused row has to be drawn again.
+     */
+    bool takeMarqueeStep();
+    /**
+     * @brief Time in milliseconds until the next marquee step, longer at both ends.
+     */
+    uint16_t getMarqueeWait() const {
+        return marqueeShift == 0 || marqueeShift == marqueeOverflow ? marqueePause : marqueeInterval;
+    }
+    /**
+     * @brief Schedule `timer` on the wheel, if there is one.
+     */
+    void schedule(MenuTimer* timer, uint32_t deadline);
+    /**
+     * @brief Cancel `timer`, if there is a wheel.
+     */
+    void cancel(MenuTimer* timer);
+    /**
+     * @brief Schedule `displayTimer` for the next power stage, if there is one.
+     */
+    void schedulePower();
+    /**
+     * @brief Enter the power stages whose timeout passed, fired by `displayTimer`.
+     */
+    void updatePower(uint32_t now);
+    /**
+     * @brief Send the commands to go from the current power stage to `state`.
+     */
+    void setPower(DisplayPower state);
+    /**
+     * @brief Advance the marquee of the focused row, fired by `marqueeTimer`.
+     * The row is drawn again by `LcdMenu::poll`, see `takeMarqueeStep`.
+     */
+    void marqueeDue(uint32_t now);
 
   public:
     /**
@@ -79,6 +194,39 @@ class MenuRenderer {
      */
     virtual void drawItem(const char* text, const char* value, bool paddWithBlanks = true) = 0;
 
+    /**
+     * @brief Draw into a part of the display, e.g. to show two menus side by side.
+     * Rows and columns of the renderer start at the origin, `getMaxCols` and `getMaxRows` return the extent.
+     * Call it before `begin`, the viewport has to lie within the display.
+     * @param col column of the display the viewport starts at
+     * @param row row of the display the viewport starts at
+     * @param cols number of columns of the viewport
+     * @param rows number of rows of the viewport
+     * @note Only `CharacterDisplayRenderer` translates what it draws, the others ignore the origin.
+     */
+    virtual void setViewport(uint8_t col, uint8_t row, uint8_t cols, uint8_t rows);
+
+    /**
+     * @brief Blank what the renderer shows, the whole display unless a viewport leaves the rest to others.
+     */
+    virtual void clear() { display->clear(); }
+
+    /**
+     * @brief Forget what is shown on the display, the next draw of every row writes all of its cells.
+     * Call it after writing to the display without the renderer.
+     */
+    virtual void invalidate() {}
+
+    /**
+     * @brief Get a character showing a custom glyph, to be used in the row being drawn.
+     * Call it from `MenuItem::draw` before `drawItem`, the character stays valid while the row is visible.
+     * @param glyph 8 byte bitmap of the glyph, 5 pixels per byte, its address identifies the glyph
+     * @param fallback character returned if the renderer can't show the glyph
+     * @param changed whether the bitmap changed since the glyph was last requested
+     * @return the character to draw
+     */
+    virtual uint8_t glyph(const uint8_t* glyph, uint8_t fallback, bool changed = false) { return fallback; }
+
     /**
      * @brief Function to clear the blinker from the display.
      */
@@ -103,20 +251,52 @@ class MenuRenderer {
     void setEditMode(bool inEditMode);
 
     /**
-     * @brief Restarts the display timer and shows the display.
+     * @brief Scroll the focused row if it is longer than the display, advanced by `LcdMenu::poll`.
+     * The text scrolls one column per step and waits at both ends, edit mode stops it.
+     * @param interval time in milliseconds between two steps, 0 disables the marquee
+     * @param pause time in milliseconds to wait at both ends
+     */
+    void setMarquee(uint16_t interval, uint16_t pause = 1000);
+
+    /**
+     * @brief Set the wheel the timers of the renderer are scheduled on.
+     * Called by `LcdMenu`, which fires the timers in `LcdMenu::poll`.
+     * @param timers the wheel, `NULL` to detach
+     */
+    void setTimers(TimerWheel* timers);
+
+    /**
+     * @brief Hide the display once there was no input for `timeout` milliseconds, fired by `LcdMenu::poll`.
+     * Same as `setPowerTimeouts(0, 0, timeout)`.
+     * @param timeout time in milliseconds, e.g. `DISPLAY_TIMEOUT`, 0 disables it
+     */
+    void setTimeout(unsigned long timeout);
+
+    /**
+     * @brief Set when the power stages are entered, fired by `LcdMenu::poll`.
+     * Each time is counted from the last input, 0 skips the stage.
+     * @param dim time in milliseconds until the backlight is dimmed to `DISPLAY_DIM_BRIGHTNESS`
+     * @param backlightOff time in milliseconds until the backlight is turned off
+     * @param displayOff time in milliseconds until the display is hidden
+     */
+    void setPowerTimeouts(unsigned long dim, unsigned long backlightOff, unsigned long displayOff);
+
+    /**
+     * @brief Get the current power stage of the display.
+     */
+    DisplayPower getPower() const { return power; }
+
+    /**
+     * @brief Restarts the display timer and wakes the display up if a power stage was entered.
      */
     virtual void restartTimer();
 
     /**
-     * @brief Updates the display timer and hides the display if the timeout is reached.
+     * @brief Updates the display timer and enters the power stages whose timeout is reached.
+     * Without `setPowerTimeouts` the display is hidden after `DISPLAY_TIMEOUT`.
+     * Not needed when the timeouts are set and `LcdMenu::poll` is called from the loop.
      */
-    virtual void updateTimer() {
-        if (millis() != startTime + DISPLAY_TIMEOUT) {
-            return;
-        }
-        LOG(F("MenuRenderer::timeout"));
-        display->hide();
-    }
+    virtual void updateTimer();
 
     /**
      * @brief Checks if the menu is in edit mode.
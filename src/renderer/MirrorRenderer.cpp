@@ -0,0 +1,373 @@
+#include "MirrorRenderer.h"
+
+void MirrorDisplay::clear() {
+    for (uint8_t i = 0; i < mirror->targetCount; i++) {
+        MenuRenderer* renderer = mirror->targets[i].renderer;
+        renderer->invalidate();
+        renderer->clear();
+    }
+    // Targets show blank rows now, so do the rows
+    for (uint8_t i = 0; i < mirror->maxRows; i++) {
+        mirror->rows[i].text = "";
+        mirror->rows[i].hasValue = false;
+        mirror->rows[i].flags = MirrorRenderer::ROW_PADDED;
+        mirror->rows[i].shift = 0;
+    }
+}
+
+void MirrorDisplay::show() {
+    for (uint8_t i = 0; i < mirror->targetCount; i++) {
+        mirror->targets[i].renderer->display->show();
+    }
+}
+
+void MirrorDisplay::hide() {
+    for (uint8_t i = 0; i < mirror->targetCount; i++) {
+        mirror->targets[i].renderer->display->hide();
+    }
+}
+
+void MirrorDisplay::draw(uint8_t byte) {
+    mirror->draw(byte);
+}
+
+void MirrorDisplay::draw(const char* text) {
+    while (*text != '\0') {
+        mirror->draw(*text++);
+    }
+}
+
+void MirrorDisplay::setCursor(uint8_t col, uint8_t row) {
+    for (uint8_t i = 0; i < mirror->targetCount; i++) {
+        mirror->targets[i].renderer->display->setCursor(col, row);
+    }
+}
+
+void MirrorDisplay::setBacklight(bool enabled) {
+    for (uint8_t i = 0; i < mirror->targetCount; i++) {
+        mirror->targets[i].renderer->display->setBacklight(enabled);
+    }
+}
+
+void MirrorDisplay::setBrightness(uint8_t brightness) {
+    for (uint8_t i = 0; i < mirror->targetCount; i++) {
+        mirror->targets[i].renderer->display->setBrightness(brightness);
+    }
+}
+
+void MirrorDisplay::commit() {
+    uint32_t now = menuMillis();
+    for (uint8_t i = 0; i < mirror->targetCount; i++) {
+        MirrorTarget& target = mirror->targets[i];
+        bool cursorDirty = target.cursorDirty && mirror->blinker;
+        if (target.dirtyRows == 0 && !cursorDirty && target.blinker == mirror->blinker && target.pendingCount == 0) {
+            continue;
+        }
+        if (target.canFlush(now)) {
+            mirror->flush(target, now);
+        } else if (!target.isArmed()) {
+            mirror->schedule(&target, target.lastFlush + target.interval);
+        }
+    }
+}
+
+void MirrorTarget::fire(uint32_t now) {
+    mirror->flush(*this, now);
+}
+
+MirrorRenderer::MirrorRenderer(uint8_t maxRows)
+    : MenuRenderer(&mirrorDisplay, 1, min(maxRows, (uint8_t)32)),
+      capacityRows(min(maxRows, (uint8_t)32)),
+      rows(new Row[capacityRows]()) {}
+
+MirrorRenderer::~MirrorRenderer() {
+    for (uint8_t i = 0; i < targetCount; i++) {
+        cancel(&targets[i]);
+    }
+    delete[] rows;
+}
+
+bool MirrorRenderer::addTarget(MenuRenderer* renderer, uint16_t interval) {
+    if (targetCount >= MIRROR_TARGETS) {
+        return false;
+    }
+    MirrorTarget& target = targets[targetCount++];
+    target.mirror = this;
+    target.renderer = renderer;
+    target.interval = interval;
+    return true;
+}
+
+void MirrorRenderer::begin() {
+    maxRows = capacityRows;
+    uint8_t cols = UINT8_MAX;
+    for (uint8_t i = 0; i < targetCount; i++) {
+        MirrorTarget& target = targets[i];
+        target.renderer->begin();
+        maxRows = min(maxRows, target.renderer->getMaxRows());
+        cols = min(cols, target.renderer->getEffectiveCols());
+        cancel(&target);
+        target.dirtyRows = 0;
+        target.cursorDirty = false;
+        target.blinker = false;
+        target.pendingCount = 0;
+        target.lastFlush = menuMillis();
+    }
+    // One more column than the room for items, like a renderer without cursor icon and with indicators
+    maxCols = cols + 1;
+    for (uint8_t i = 0; i < capacityRows; i++) {
+        rows[i].text = NULL;
+    }
+    memset(glyphs, 0, sizeof(glyphs));
+    blinker = false;
+    MenuRenderer::begin();
+}
+
+void MirrorRenderer::drawItem(const char* text, const char* value, bool paddWithBlanks) {
+    uint8_t index = cursorRow;
+    if (index >= maxRows) {
+        return;
+    }
+    uint8_t shift = 0;
+    if (hasFocus) {
+        uint8_t length = strlen(text) + (value ? strlen(value) + 1 : 0);
+        uint8_t room = getEffectiveCols();
+        shift = viewShift + getMarqueeShift(text, length > room ? length - room : 0);
+    }
+    uint8_t flags = (hasFocus ? ROW_FOCUS : 0) | (hasHiddenItemsAbove ? ROW_ABOVE : 0) |
+                    (hasHiddenItemsBelow ? ROW_BELOW : 0) | (paddWithBlanks ? ROW_PADDED : 0) |
+                    (inEditMode ? ROW_EDIT : 0);
+    Row& row = rows[index];
+    bool changed = row.text != text || row.flags != flags || row.shift != shift || row.hasValue != (value != NULL);
+    // Targets which didn't get the new bitmap of a glyph of the row yet
+    uint8_t glyphTargets = 0;
+    if (value != NULL) {
+        char copy[ITEM_DRAW_BUFFER_SIZE];
+        strncpy(copy, value, sizeof(copy) - 1);
+        copy[sizeof(copy) - 1] = '\0';
+        for (const char* c = copy; *c != '\0'; c++) {
+            if ((uint8_t)*c <= 7) {
+                glyphTargets |= glyphs[*c - 1].changed;
+            }
+        }
+        if (strcmp(row.value, copy) != 0) {
+            memcpy(row.value, copy, sizeof(copy));
+            changed = true;
+        }
+    }
+    if (changed) {
+        row.text = text;
+        row.hasValue = value != NULL;
+        row.flags = flags;
+        row.shift = shift;
+        glyphTargets = UINT8_MAX;
+    }
+    markDirty((uint32_t)1 << index, glyphTargets);
+    rowGlyphs = 0;
+    if (hasFocus) {
+        focusEnd = getEndCol(text, value, shift);
+        moveCursor(focusEnd, index);
+    }
+}
+
+uint8_t MirrorRenderer::getEndCol(const char* text, const char* value, uint8_t shift) const {
+    uint8_t room = getEffectiveCols();
+    uint8_t textLen = strlen(text);
+    uint8_t col = min(shift < textLen ? textLen - shift : 0, (int)room);
+    if (value != NULL && col < room && shift < textLen + 1) {
+        col++;
+    }
+    if (value != NULL) {
+        uint8_t valueShift = shift > textLen ? shift - textLen - 1 : 0;
+        uint8_t valueLen = strlen(value);
+        col = min(col + (valueShift < valueLen ? valueLen - valueShift : 0), (int)room);
+    }
+    return col;
+}
+
+uint8_t MirrorRenderer::glyph(const uint8_t* glyph, uint8_t fallback, bool changed) {
+    for (uint8_t pass = 0; pass < 2; pass++) {
+        uint8_t free = 7;
+        for (uint8_t i = 0; i < 7; i++) {
+            if (glyphs[i].bitmap == glyph) {
+                glyphs[i].fallback = fallback;
+                if (changed) {
+                    glyphs[i].changed = UINT8_MAX;
+                }
+                bitSet(rowGlyphs, i);
+                return i + 1;
+            }
+            if (glyphs[i].bitmap == NULL && free == 7) {
+                free = i;
+            }
+        }
+        if (free < 7) {
+            glyphs[free].bitmap = glyph;
+            glyphs[free].fallback = fallback;
+            glyphs[free].changed = UINT8_MAX;
+            bitSet(rowGlyphs, free);
+            return free + 1;
+        }
+        releaseGlyphs();
+    }
+    return fallback;
+}
+
+void MirrorRenderer::releaseGlyphs() {
+    uint8_t used = rowGlyphs;
+    for (uint8_t i = 0; i < maxRows; i++) {
+        if (rows[i].text == NULL || !rows[i].hasValue) {
+            continue;
+        }
+        for (const char* c = rows[i].value; *c != '\0'; c++) {
+            if ((uint8_t)*c <= 7) {
+                bitSet(used, *c - 1);
+            }
+        }
+    }
+    for (uint8_t i = 0; i < 7; i++) {
+        if (!bitRead(used, i)) {
+            glyphs[i].bitmap = NULL;
+        }
+    }
+}
+
+void MirrorRenderer::markDirty(uint32_t rowMask, uint8_t targetMask) {
+    for (uint8_t i = 0; i < targetCount; i++) {
+        if (!bitRead(targetMask, i)) {
+            continue;
+        }
+        MirrorTarget& target = targets[i];
+        target.dirtyRows |= rowMask;
+        // Redrawn rows cover the bytes drawn on them
+        uint8_t kept = 0;
+        for (uint8_t j = 0; j < target.pendingCount; j++) {
+            if (!(rowMask & ((uint32_t)1 << target.pending[j].row))) {
+                target.pending[kept++] = target.pending[j];
+            }
+        }
+        target.pendingCount = kept;
+    }
+}
+
+void MirrorRenderer::flush(MirrorTarget& target, uint32_t now) {
+    cancel(&target);
+    target.lastFlush = now;
+    for (uint8_t i = 0; i < maxRows; i++) {
+        if (target.dirtyRows & ((uint32_t)1 << i)) {
+            drawRow(target, i);
+        }
+    }
+    target.dirtyRows = 0;
+    MenuRenderer* renderer = target.renderer;
+    for (uint8_t i = 0; i < target.pendingCount; i++) {
+        const MirrorTarget::PendingDraw& draw = target.pending[i];
+        int16_t col = (int16_t)target.focusEnd + draw.col - focusEnd;
+        renderer->moveCursor(col > 0 ? col : 0, draw.row);
+        renderer->draw(draw.byte);
+        target.cursorDirty = true;
+    }
+    target.pendingCount = 0;
+    // Cursor is only seen with the blinker, it keeps its distance to the end of the focused row
+    if (target.cursorDirty && blinker) {
+        int16_t col = (int16_t)target.focusEnd + cursorCol - focusEnd;
+        renderer->moveCursor(col > 0 ? col : 0, cursorRow);
+        target.cursorDirty = false;
+    }
+    if (target.blinker != blinker) {
+        blinker ? renderer->drawBlinker() : renderer->clearBlinker();
+        target.blinker = blinker;
+    }
+    renderer->display->commit();
+}
+
+void MirrorRenderer::drawRow(MirrorTarget& target, uint8_t index) {
+    Row& row = rows[index];
+    if (row.text == NULL) {
+        return;
+    }
+    MenuRenderer* renderer = target.renderer;
+    uint8_t targetBit = &target - targets;
+    char value[ITEM_DRAW_BUFFER_SIZE];
+    if (row.hasValue) {
+        // Each target has its own slots for the glyphs
+        for (uint8_t i = 0; i < sizeof(value); i++) {
+            uint8_t c = row.value[i];
+            if (c != '\0' && c <= 7) {
+                Glyph& glyph = glyphs[c - 1];
+                c = renderer->glyph(glyph.bitmap, glyph.fallback, bitRead(glyph.changed, targetBit));
+                bitClear(glyph.changed, targetBit);
+            }
+            value[i] = c;
+            if (c == '\0') break;
+        }
+    }
+    renderer->hasFocus = row.flags & ROW_FOCUS;
+    renderer->hasHiddenItemsAbove = row.flags & ROW_ABOVE;
+    renderer->hasHiddenItemsBelow = row.flags & ROW_BELOW;
+    renderer->inEditMode = row.flags & ROW_EDIT;
+    renderer->viewShift = row.shift;
+    renderer->cursorRow = index;
+    renderer->drawItem(row.text, row.hasValue ? value : NULL, row.flags & ROW_PADDED);
+    if (row.flags & ROW_FOCUS) {
+        target.focusEnd = renderer->getCursorCol();
+        target.cursorDirty = true;
+    }
+}
+
+void MirrorRenderer::draw(uint8_t byte) {
+    uint32_t now = menuMillis();
+    for (uint8_t i = 0; i < targetCount; i++) {
+        MirrorTarget& target = targets[i];
+        if (!target.canFlush(now) && target.pendingCount < MIRROR_PENDING_DRAWS) {
+            // A byte at the same place replaces the one drawn there before
+            uint8_t j = 0;
+            while (j < target.pendingCount && (target.pending[j].col != cursorCol || target.pending[j].row != cursorRow)) {
+                j++;
+            }
+            if (j == target.pendingCount) {
+                target.pendingCount++;
+            }
+            target.pending[j] = {cursorCol, cursorRow, byte};
+            if (!target.isArmed()) {
+                schedule(&target, target.lastFlush + target.interval);
+            }
+            continue;
+        }
+        // Cursor of the target has to be in place first, a full queue is flushed regardless of the budget
+        flush(target, now);
+        target.renderer->draw(byte);
+        target.renderer->display->commit();
+    }
+    // Like on a display, the next byte goes to the next column
+    cursorCol++;
+}
+
+void MirrorRenderer::invalidate() {
+    for (uint8_t i = 0; i < targetCount; i++) {
+        targets[i].renderer->invalidate();
+    }
+    markDirty(UINT32_MAX);
+}
+
+void MirrorRenderer::drawBlinker() {
+    blinker = true;
+}
+
+void MirrorRenderer::clearBlinker() {
+    blinker = false;
+}
+
+void MirrorRenderer::moveCursor(uint8_t cursorCol, uint8_t cursorRow) {
+    if (cursorCol == this->cursorCol && cursorRow == this->cursorRow) {
+        return;
+    }
+    MenuRenderer::moveCursor(cursorCol, cursorRow);
+    for (uint8_t i = 0; i < targetCount; i++) {
+        targets[i].cursorDirty = true;
+    }
+}
+
+uint8_t MirrorRenderer::getEffectiveCols() const {
+    return maxCols - 1;
+}
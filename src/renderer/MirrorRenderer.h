@@ -0,0 +1,231 @@
+#pragma once
+
+#include "MenuRenderer.h"
+#include <widget/BaseWidget.h>
+
+static_assert(MIRROR_TARGETS <= 8, "MIRROR_TARGETS must be at most 8, targets are kept in 8 bit masks");
+
+class MirrorRenderer;
+
+/**
+ * @brief Display of `MirrorRenderer`, it forwards what the menu does to the display to the displays of the targets.
+ */
+class MirrorDisplay : public DisplayInterface {
+  protected:
+    MirrorRenderer* mirror;
+
+  public:
+    explicit MirrorDisplay(MirrorRenderer* mirror) : mirror(mirror) {}
+    void begin() override {}
+    void clear() override;
+    void show() override;
+    void hide() override;
+    void draw(uint8_t byte) override;
+    void draw(const char* text) override;
+    void setCursor(uint8_t col, uint8_t row) override;
+    void setBacklight(bool enabled) override;
+    void setBrightness(uint8_t brightness) override;
+    /**
+     * @brief Flush the targets whose budget allows it, the others are flushed by their timer.
+     */
+    void commit() override;
+};
+
+/**
+ * @brief Renderer the menu is mirrored to, with what it still has to show.
+ */
+class MirrorTarget : public MenuTimer {
+    friend class MirrorRenderer;
+    friend class MirrorDisplay;
+
+  protected:
+    /**
+     * @brief Byte drawn at the cursor of the mirror, in its columns.
+     */
+    struct PendingDraw {
+        uint8_t col;
+        uint8_t row;
+        uint8_t byte;
+    };
+
+    MirrorRenderer* mirror = NULL;
+    MenuRenderer* renderer = NULL;
+    /**
+     * @brief Shortest time in milliseconds between two flushes, 0 flushes every frame.
+     */
+    uint16_t interval = 0;
+    uint32_t lastFlush = 0;
+    /**
+     * @brief Rows changed since the last flush, one bit per row.
+     */
+    uint32_t dirtyRows = 0;
+    /**
+     * @brief Column the target put the cursor at when it drew the focused row.
+     */
+    uint8_t focusEnd = 0;
+    bool cursorDirty = false;
+    bool blinker = false;
+    /**
+     * @brief Bytes drawn since the last flush, drawn over the rows by the next one.
+     */
+    PendingDraw pending[MIRROR_PENDING_DRAWS];
+    uint8_t pendingCount = 0;
+
+    /**
+     * @brief Check whether the budget of the target allows a flush now.
+     */
+    bool canFlush(uint32_t now) const {
+        return interval == 0 || (uint32_t)(now - lastFlush) >= interval;
+    }
+    void fire(uint32_t now) override;
+};
+
+/**
+ * @class MirrorRenderer
+ * @brief Shows one menu on several renderers, e.g. the LCD of the front panel and a terminal on the service port.
+ *
+ * The menu draws into the mirror, which keeps the text and the value of every
+ * row and marks the rows which changed for each target. A target is flushed
+ * when the menu commits a frame, the rows it didn't see are drawn on it with its
+ * own geometry and its own shadow decides which cells are written. A target
+ * without changes is skipped.
+ *
+ * Each target has a budget: the shortest time between two of its flushes.
+ * Frames committed in between are collected and flushed at once by a timer
+ * fired from `LcdMenu::poll`, so a slow target, like a terminal at 9600 baud,
+ * shows the latest state a bit later without slowing down the others. Bytes
+ * drawn at the cursor, like the character picked by `ItemInputCharset`, are
+ * kept for the next flush as well.
+ *
+ * The menu sees the smallest geometry of the targets: the fewest rows and the
+ * narrowest room for items. Custom glyphs are requested from every target,
+ * targets without them show their fallback. The marquee and the power stages
+ * are set on the mirror, not on the targets.
+ *
+ * @example
+ *   CharacterDisplayRenderer lcdRenderer(&lcdAdapter, 16, 2);
+ *   AnsiRenderer terminalRenderer(&Serial, 40, 2);
+ *   MirrorRenderer renderer(2);
+ *   LcdMenu menu(renderer);
+ *   void setup() {
+ *       renderer.addTarget(&lcdRenderer);
+ *       renderer.addTarget(&terminalRenderer, 200);  // At most 5 frames per second
+ *       renderer.begin();
+ *   }
+ */
+class MirrorRenderer : public MenuRenderer {
+    friend class MirrorDisplay;
+    friend class MirrorTarget;
+
+  protected:
+    /**
+     * @brief Row as the menu last drew it.
+     */
+    struct Row {
+        /**
+         * @brief Text of the item, items keep it while they exist, `NULL` if not drawn yet.
+         */
+        const char* text;
+        /**
+         * @brief Copy of the value, glyphs are stored as their index in `glyphs` plus one.
+         */
+        char value[ITEM_DRAW_BUFFER_SIZE];
+        bool hasValue;
+        uint8_t flags;
+        uint8_t shift;
+    };
+    enum RowFlag : uint8_t {
+        ROW_FOCUS = 1,
+        ROW_ABOVE = 2,
+        ROW_BELOW = 4,
+        ROW_PADDED = 8,
+        ROW_EDIT = 16,
+    };
+    /**
+     * @brief Glyph requested by an item, it keeps the bitmap.
+     */
+    struct Glyph {
+        const uint8_t* bitmap;
+        uint8_t fallback;
+        /**
+         * @brief Targets which didn't get the current bitmap yet, one bit per target.
+         */
+        uint8_t changed;
+    };
+
+    MirrorDisplay mirrorDisplay{this};
+    MirrorTarget targets[MIRROR_TARGETS];
+    uint8_t targetCount = 0;
+    const uint8_t capacityRows;
+    Row* rows;
+    Glyph glyphs[7] = {};
+    /**
+     * @brief Glyphs handed out for the row being drawn, they are kept until it is.
+     */
+    uint8_t rowGlyphs = 0;
+    /**
+     * @brief Column the mirror put the cursor at when it drew the focused row.
+     */
+    uint8_t focusEnd = 0;
+    bool blinker = false;
+
+    /**
+     * @brief Draw the changes the target didn't see yet.
+     */
+    void flush(MirrorTarget& target, uint32_t now);
+    /**
+     * @brief Draw a cached row on a target.
+     */
+    void drawRow(MirrorTarget& target, uint8_t index);
+    /**
+     * @brief Mark rows as changed for some targets.
+     * @param rowMask one bit per row
+     * @param targetMask one bit per target, all targets by default
+     */
+    void markDirty(uint32_t rowMask, uint8_t targetMask = UINT8_MAX);
+    /**
+     * @brief Get the column the cursor ends at after the focused row, like a renderer without cursor icon.
+     */
+    uint8_t getEndCol(const char* text, const char* value, uint8_t shift) const;
+    /**
+     * @brief Free the glyphs no row shows anymore.
+     */
+    void releaseGlyphs();
+    uint8_t getEffectiveCols() const override;
+
+  public:
+    /**
+     * @param maxRows largest number of rows shown, the targets with fewer rows reduce it in `begin`
+     */
+    explicit MirrorRenderer(uint8_t maxRows);
+    ~MirrorRenderer();
+
+    /**
+     * @brief Add a renderer to mirror the menu to, before `begin`.
+     * @param renderer the renderer, it must not be used by a menu itself
+     * @param interval shortest time in milliseconds between two updates of the renderer, 0 updates it with every frame
+     * @return false if there are already `MIRROR_TARGETS` targets
+     */
+    bool addTarget(MenuRenderer* renderer, uint16_t interval = 0);
+    /**
+     * @brief Begin all targets and take the smallest geometry of them.
+     */
+    void begin() override;
+    /**
+     * @brief Keep the row and mark it changed for the targets if it differs from what they were sent before.
+     */
+    void drawItem(const char* text, const char* value, bool paddWithBlanks = true) override;
+    /**
+     * @brief Get a character standing for a glyph, each target gets its own slot or fallback when the row is drawn.
+     */
+    uint8_t glyph(const uint8_t* glyph, uint8_t fallback, bool changed = false) override;
+    /**
+     * @brief Draw a byte at the cursor of the targets whose budget allows it,
+     * the others get it with their next flush.
+     */
+    void draw(uint8_t byte) override;
+    void invalidate() override;
+    void drawBlinker() override;
+    void clearBlinker() override;
+    void moveCursor(uint8_t cursorCol, uint8_t cursorRow) override;
+};
@@ -0,0 +1,199 @@
+#include "RemoteRenderer.h"
+
+/**
+ * @brief FNV-1a hash of a text, to notice texts rewritten in place without keeping a copy.
+ */
+static uint32_t hashText(const char* text) {
+    uint32_t hash = 2166136261UL;
+    while (*text != '\0') {
+        hash = (hash ^ (uint8_t)*text++) * 16777619UL;
+    }
+    return hash;
+}
+
+void RemoteDisplay::clear() {
+    renderer->clearRows();
+}
+
+void RemoteDisplay::draw(uint8_t byte) {
+    renderer->draw(byte);
+}
+
+void RemoteDisplay::draw(const char* text) {
+    while (*text != '\0') {
+        renderer->draw(*text++);
+    }
+}
+
+void RemoteDisplay::setCursor(uint8_t col, uint8_t row) {
+    renderer->drawCol = col;
+    renderer->drawRow = row;
+}
+
+void RemoteDisplay::commit() {
+    renderer->flush();
+}
+
+RemoteRenderer::RemoteRenderer(Print* out, uint8_t maxCols, uint8_t maxRows)
+    : MenuRenderer(&remoteDisplay, maxCols, min(maxRows, (uint8_t)32)),
+      out(out),
+      rows(new Row[this->maxRows]()) {}
+
+RemoteRenderer::~RemoteRenderer() {
+    delete[] rows;
+}
+
+void RemoteRenderer::begin() {
+    MenuRenderer::begin();
+    for (uint8_t i = 0; i < maxRows; i++) {
+        rows[i].text = NULL;
+    }
+    dirtyRows = 0;
+    cursorDirty = false;
+    blinker = false;
+}
+
+void RemoteRenderer::setSubscribed(bool subscribed) {
+    this->subscribed = subscribed;
+}
+
+void RemoteRenderer::drawItem(const char* text, const char* value, bool paddWithBlanks) {
+    uint8_t index = cursorRow;
+    if (index >= maxRows) {
+        return;
+    }
+    uint8_t flags = (hasFocus ? REMOTE_ROW_FOCUS : 0) | (hasHiddenItemsAbove ? REMOTE_ROW_ABOVE : 0) |
+                    (hasHiddenItemsBelow ? REMOTE_ROW_BELOW : 0) | (value != NULL ? REMOTE_ROW_VALUE : 0) |
+                    (inEditMode ? REMOTE_ROW_EDIT : 0);
+    uint8_t shift = hasFocus ? viewShift : 0;
+    Row& row = rows[index];
+    uint32_t textHash = hashText(text);
+    bool changed = row.text != text || row.textHash != textHash || row.flags != flags || row.shift != shift;
+    if (value != NULL && strncmp(row.value, value, sizeof(row.value) - 1) != 0) {
+        strncpy(row.value, value, sizeof(row.value) - 1);
+        row.value[sizeof(row.value) - 1] = '\0';
+        changed = true;
+    }
+    if (changed) {
+        row.text = text;
+        row.textHash = textHash;
+        row.flags = flags;
+        row.shift = shift;
+        dirtyRows |= (uint32_t)1 << index;
+    }
+    if (hasFocus) {
+        // Cursor ends after the row, like on a display without cursor icon
+        uint8_t length = strlen(text) + (value != NULL ? strlen(value) + 1 : 0);
+        length = length > shift ? length - shift : 0;
+        moveCursor(min(length, maxCols), index);
+    }
+}
+
+void RemoteRenderer::clearRows() {
+    for (uint8_t i = 0; i < maxRows; i++) {
+        Row& row = rows[i];
+        if (row.text == NULL || row.text[0] != '\0' || row.flags != 0) {
+            row.text = "";
+            row.textHash = hashText("");
+            row.flags = 0;
+            row.shift = 0;
+            dirtyRows |= (uint32_t)1 << i;
+        }
+    }
+}
+
+void RemoteRenderer::flush() {
+    if (subscribed) {
+        for (uint8_t i = 0; i < maxRows; i++) {
+            if (dirtyRows & ((uint32_t)1 << i)) {
+                sendRow(i);
+            }
+        }
+        if (cursorDirty) {
+            sendCursor();
+        }
+    }
+    dirtyRows = 0;
+    cursorDirty = false;
+}
+
+void RemoteRenderer::sendScreen() {
+    RemoteFrameWriter frame(*out, REMOTE_SCREEN, 2);
+    frame.write(maxCols);
+    frame.write(maxRows);
+    frame.end();
+    for (uint8_t i = 0; i < maxRows; i++) {
+        sendRow(i);
+    }
+    sendCursor();
+    dirtyRows = 0;
+    cursorDirty = false;
+}
+
+void RemoteRenderer::sendRow(uint8_t index) {
+    const Row& row = rows[index];
+    const char* text = row.text != NULL ? row.text : "";
+    const char* value = row.flags & REMOTE_ROW_VALUE ? row.value : "";
+    // Text and value are cut to fit into the payload
+    uint8_t room = REMOTE_PAYLOAD_SIZE - 4;
+    uint8_t textLength = min(strlen(text), (size_t)room);
+    uint8_t valueLength = min(strlen(value), (size_t)(room - textLength));
+    RemoteFrameWriter frame(*out, REMOTE_ROW, 4 + textLength + valueLength);
+    frame.write(index);
+    frame.write(row.text != NULL ? row.flags : 0);
+    frame.write(row.shift);
+    frame.write(textLength);
+    frame.write(text, textLength);
+    frame.write(value, valueLength);
+    frame.end();
+}
+
+void RemoteRenderer::sendCursor() {
+    RemoteFrameWriter frame(*out, REMOTE_CURSOR, 3);
+    frame.write(shownCol);
+    frame.write(shownRow);
+    frame.write((blinker ? REMOTE_CURSOR_BLINK : 0) | (inEditMode ? REMOTE_CURSOR_EDIT : 0));
+    frame.end();
+}
+
+void RemoteRenderer::draw(uint8_t byte) {
+    // Rows first, the byte is drawn over them
+    flush();
+    if (subscribed) {
+        RemoteFrameWriter frame(*out, REMOTE_DRAW, 3);
+        frame.write(drawCol);
+        frame.write(drawRow);
+        frame.write(byte);
+        frame.end();
+    }
+    drawCol++;
+}
+
+void RemoteRenderer::drawBlinker() {
+    if (!blinker) {
+        blinker = true;
+        cursorDirty = true;
+    }
+}
+
+void RemoteRenderer::clearBlinker() {
+    if (blinker) {
+        blinker = false;
+        cursorDirty = true;
+    }
+}
+
+void RemoteRenderer::moveCursor(uint8_t cursorCol, uint8_t cursorRow) {
+    if (cursorCol != shownCol || cursorRow != shownRow) {
+        shownCol = cursorCol;
+        shownRow = cursorRow;
+        cursorDirty = true;
+    }
+    MenuRenderer::moveCursor(cursorCol, cursorRow);
+    drawCol = cursorCol;
+    drawRow = cursorRow;
+}
+
+uint8_t RemoteRenderer::getEffectiveCols() const {
+    return maxCols;
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "MenuRenderer.h"
+#include <utils/RemoteFrame.h>
+#include <widget/BaseWidget.h>
+
+class RemoteRenderer;
+
+/**
+ * @brief Display of `RemoteRenderer`, it forwards what the menu does to the display to the renderer.
+ */
+class RemoteDisplay : public DisplayInterface {
+  protected:
+    RemoteRenderer* renderer;
+
+  public:
+    explicit RemoteDisplay(RemoteRenderer* renderer) : renderer(renderer) {}
+    void begin() override {}
+    void clear() override;
+    /**
+     * @brief The remote keeps showing the menu while the display is hidden, the power stages do nothing.
+     */
+    void show() override {}
+    void hide() override {}
+    void draw(uint8_t byte) override;
+    void draw(const char* text) override;
+    void setCursor(uint8_t col, uint8_t row) override;
+    void setBacklight(bool enabled) override {}
+    /**
+     * @brief Send the changes of the frame to a subscribed remote.
+     */
+    void commit() override;
+};
+
+/**
+ * @class RemoteRenderer
+ * @brief Sends the menu as frames of the remote protocol, for a PC or another MCU to show and drive it.
+ *
+ * The renderer keeps the text, the value and the flags of every row. A remote
+ * asks for the whole screen with `REMOTE_READ` or subscribes to the changes,
+ * which are sent when the menu commits a frame: the rows which changed and the
+ * cursor if it moved. Rows are sent as text and value, the remote lays them out
+ * on its own, so the renderer is as wide as the menu should be. Frames are
+ * written straight to the stream, nothing is allocated after the constructor.
+ * See `RemoteFrame.h` for the format.
+ *
+ * Use it as the renderer of a menu without display, or as a target of a
+ * `MirrorRenderer` to mirror a menu shown on a display. `RemoteAdapter` reads
+ * the frames of the remote from the stream.
+ *
+ * @example
+ *   CharacterDisplayRenderer lcdRenderer(&lcdAdapter, 16, 2);
+ *   RemoteRenderer remoteRenderer(&Serial, 16, 2);
+ *   MirrorRenderer renderer(2);
+ *   LcdMenu menu(renderer);
+ *   RemoteAdapter remote(&menu, &Serial, &remoteRenderer);
+ */
+class RemoteRenderer : public MenuRenderer {
+    friend class RemoteDisplay;
+
+  protected:
+    /**
+     * @brief Row as the menu last drew it.
+     */
+    struct Row {
+        /**
+         * @brief Text of the item, items keep it while they exist, `NULL` if not drawn yet.
+         */
+        const char* text;
+        /**
+         * @brief Hash of the content of `text` when it was drawn, items may rewrite their text in place.
+         */
+        uint32_t textHash;
+        char value[ITEM_DRAW_BUFFER_SIZE];
+        /**
+         * @brief `RemoteRowFlag`s of the row.
+         */
+        uint8_t flags;
+        uint8_t shift;
+    };
+
+    RemoteDisplay remoteDisplay{this};
+    Print* out;
+    Row* rows;
+    /**
+     * @brief Rows changed since the last frame, one bit per row.
+     */
+    uint32_t dirtyRows = 0;
+    bool cursorDirty = false;
+    bool blinker = false;
+    bool subscribed = false;
+    /**
+     * @brief Column and row the cursor was moved to, `cursorRow` also follows the row being drawn.
+     */
+    uint8_t shownCol = 0;
+    uint8_t shownRow = 0;
+    /**
+     * @brief Column and row the next byte of `draw` goes to.
+     */
+    uint8_t drawCol = 0;
+    uint8_t drawRow = 0;
+
+    void sendRow(uint8_t index);
+    void sendCursor();
+    /**
+     * @brief Send the changed rows and the cursor to a subscribed remote, forget them otherwise.
+     */
+    void flush();
+    /**
+     * @brief Blank all rows, like a cleared display.
+     */
+    void clearRows();
+
+  public:
+    /**
+     * @param out stream to write the frames to
+     * @param maxCols number of columns of the menu, the remote may show more
+     * @param maxRows number of rows of the menu, at most 32
+     */
+    RemoteRenderer(Print* out, uint8_t maxCols, uint8_t maxRows);
+    ~RemoteRenderer();
+
+    /**
+     * @brief Send the changes with every frame, or stop it.
+     */
+    void setSubscribed(bool subscribed);
+    bool isSubscribed() const { return subscribed; }
+    /**
+     * @brief Send the whole screen: `REMOTE_SCREEN`, every row and the cursor.
+     */
+    void sendScreen();
+
+    void begin() override;
+    /**
+     * @brief Keep the row and mark it changed if it differs from what was sent before.
+     */
+    void drawItem(const char* text, const char* value, bool paddWithBlanks = true) override;
+    /**
+     * @brief Send a byte drawn at the cursor right away, after the changed rows.
+     */
+    void draw(uint8_t byte) override;
+    void drawBlinker() override;
+    void clearBlinker() override;
+    void moveCursor(uint8_t cursorCol, uint8_t cursorRow) override;
+    uint8_t getEffectiveCols() const override;
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+#if defined(ARDUINO_ARCH_ESP32)
+// Part of the core
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#elif defined(__has_include)
+#if __has_include(<Arduino_FreeRTOS.h>)
+#include <Arduino_FreeRTOS.h>
+#elif __has_include(<FreeRTOS.h>)
+#include <FreeRTOS.h>
+#include <task.h>
+#endif
+#else
+#include <Arduino_FreeRTOS.h>
+#endif
+
+/**
+ * @brief Lock for `UpdateQueue` shared between FreeRTOS tasks.
+ *
+ * Uses a critical section, which is cheap for the few bytes copied while it
+ * is held and never makes the posting task wait for the scheduler.
+ * On AVR it needs the `Arduino_FreeRTOS` library, on ESP32 FreeRTOS is part
+ * of the core.
+ */
+class FreeRTOSLock {
+#if defined(ARDUINO_ARCH_ESP32)
+    portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+
+  public:
+    void lock() { taskENTER_CRITICAL(&mux); }
+    void unlock() { taskEXIT_CRITICAL(&mux); }
+#else
+  public:
+    void lock() { taskENTER_CRITICAL(); }
+    void unlock() { taskEXIT_CRITICAL(); }
+#endif
+};
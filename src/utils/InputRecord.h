@@ -0,0 +1,156 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Format of recorded input, see `InputRecorder` and `InputReplay`.
+ *
+ * Each record is the time in milliseconds since the previous record, as a
+ * variable length integer of 7 bits per byte with the high bit set on all but
+ * the last byte, followed by the command byte. Commands less than 128 ms apart
+ * take 2 bytes.
+ */
+
+/**
+ * @brief Write a record.
+ * @param out where to write it
+ * @param delta time in milliseconds since the previous record
+ * @param command the command
+ * @return number of bytes written, 0 if `out` is full
+ */
+inline uint8_t writeInputRecord(Print& out, uint32_t delta, unsigned char command) {
+    uint8_t bytes[6];
+    uint8_t length = 0;
+    while (delta >= 0x80) {
+        bytes[length++] = (delta & 0x7F) | 0x80;
+        delta >>= 7;
+    }
+    bytes[length++] = delta;
+    bytes[length++] = command;
+    return out.write(bytes, length) == length ? length : 0;
+}
+
+/**
+ * @brief Decoder of records, fed one byte at a time so records may arrive in pieces.
+ */
+class InputRecordReader {
+  protected:
+    uint32_t value = 0;
+    uint8_t shift = 0;
+    bool hasDelta = false;
+
+  public:
+    /**
+     * @brief Time in milliseconds since the previous record, valid once `feed` returned true.
+     */
+    uint32_t delta = 0;
+    /**
+     * @brief The command, valid once `feed` returned true.
+     */
+    unsigned char command = 0;
+    /**
+     * @brief Decode the next byte.
+     * @return true if it completed a record
+     */
+    bool feed(uint8_t byte) {
+        if (hasDelta) {
+            command = byte;
+            hasDelta = false;
+            return true;
+        }
+        if (shift < 32) {
+            value |= (uint32_t)(byte & 0x7F) << shift;
+        }
+        shift += 7;
+        if ((byte & 0x80) == 0) {
+            delta = value;
+            value = 0;
+            shift = 0;
+            hasDelta = true;
+        }
+        return false;
+    }
+    /**
+     * @brief Decode the next record from a stream.
+     * @return true if a record was read, false if the stream has no more bytes for now
+     */
+    bool read(Stream& in) {
+        while (in.available() > 0) {
+            if (feed(in.read())) {
+                return true;
+            }
+        }
+        return false;
+    }
+    /**
+     * @brief Drop a partially decoded record.
+     */
+    void reset() {
+        value = 0;
+        shift = 0;
+        hasDelta = false;
+    }
+};
+
+/**
+ * @brief Stream over a byte array, to record input into memory and replay it from there.
+ *
+ * Written bytes are appended until the array is full, read bytes are consumed
+ * from the start, `rewind` reads the recording again.
+ *
+ * @example
+ *   uint8_t storage[128];
+ *   RecordBuffer recording(storage, sizeof(storage));
+ */
+class RecordBuffer : public Stream {
+  protected:
+    uint8_t* data;
+    size_t capacity;
+    size_t length;
+    size_t position = 0;
+
+  public:
+    /**
+     * @param data the array, must stay valid
+     * @param capacity size of the array
+     * @param length number of bytes already recorded in it, e.g. for a recording stored in the sketch
+     */
+    RecordBuffer(uint8_t* data, size_t capacity, size_t length = 0)
+        : data(data), capacity(capacity), length(length) {}
+
+    size_t write(uint8_t byte) override {
+        if (length >= capacity) {
+            return 0;
+        }
+        data[length++] = byte;
+        return 1;
+    }
+    int available() override {
+        return length - position;
+    }
+    int read() override {
+        return position < length ? data[position++] : -1;
+    }
+    int peek() override {
+        return position < length ? data[position] : -1;
+    }
+    /**
+     * @brief Read the recording again from the start.
+     */
+    void rewind() {
+        position = 0;
+    }
+    /**
+     * @brief Drop the recording.
+     */
+    void clear() {
+        length = 0;
+        position = 0;
+    }
+    const uint8_t* getData() const {
+        return data;
+    }
+    size_t getLength() const {
+        return length;
+    }
+};
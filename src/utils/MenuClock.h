@@ -0,0 +1,92 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Source of the time in milliseconds for everything time driven in the library.
+ *
+ * Times are 32 bit and wrap around after 49.7 days, they are only compared by
+ * their difference, e.g. `(uint32_t)(now - start) >= timeout`.
+ */
+class MenuClock {
+  public:
+    virtual ~MenuClock() = default;
+    /**
+     * @brief Get the current time in milliseconds.
+     */
+    virtual uint32_t now() = 0;
+};
+
+/**
+ * @brief Clock reading `millis()`, used by default.
+ */
+class ArduinoClock : public MenuClock {
+  public:
+    uint32_t now() override {
+        return millis();
+    }
+};
+
+/**
+ * @brief Clock which only moves when it is told to, for deterministic tests.
+ *
+ * @example
+ *   ManualClock clock(0xFFFFFF00);  // 256 ms before the wrap around
+ *   setMenuClock(&clock);
+ *   clock.advance(DISPLAY_TIMEOUT);
+ *   menu.poll();
+ */
+class ManualClock : public MenuClock {
+  protected:
+    uint32_t time;
+
+  public:
+    explicit ManualClock(uint32_t time = 0) : time(time) {}
+    uint32_t now() override {
+        return time;
+    }
+    /**
+     * @brief Set the current time in milliseconds.
+     */
+    void set(uint32_t time) {
+        this->time = time;
+    }
+    /**
+     * @brief Move the time forward, it wraps around like `millis()`.
+     */
+    void advance(uint32_t ms) {
+        time += ms;
+    }
+};
+
+/**
+ * @brief Get the default clock.
+ */
+inline MenuClock* getArduinoClock() {
+    static ArduinoClock clock;
+    return &clock;
+}
+
+/**
+ * @brief Get the clock used by the library.
+ */
+inline MenuClock*& menuClock() {
+    static MenuClock* clock = getArduinoClock();
+    return clock;
+}
+
+/**
+ * @brief Replace the clock used by the library, e.g. with a `ManualClock` in tests.
+ * Set it before the menu is started, timers keep the deadlines they were scheduled with.
+ * @param clock the clock, `NULL` restores the `ArduinoClock`
+ */
+inline void setMenuClock(MenuClock* clock) {
+    menuClock() = clock != NULL ? clock : getArduinoClock();
+}
+
+/**
+ * @brief Get the current time in milliseconds from the clock of the library.
+ */
+inline uint32_t menuMillis() {
+    return menuClock()->now();
+}
@@ -0,0 +1,204 @@
+#pragma once
+
+#include "constants.h"
+#include <Arduino.h>
+
+/**
+ * @brief Frames of the remote protocol, see `RemoteAdapter` and `RemoteRenderer`.
+ *
+ * ```
+ * 0xA5 | type | length | payload (length bytes) | CRC low | CRC high
+ * ```
+ *
+ * The CRC is CRC-16/CCITT-FALSE over type, length and payload. A receiver
+ * drops frames with a wrong CRC or a payload longer than `REMOTE_PAYLOAD_SIZE`
+ * and looks for the next start byte.
+ *
+ * Frames sent to the unit:
+ * - `REMOTE_INPUT`: commands to process, one per byte, answered with `REMOTE_ACK`
+ * - `REMOTE_READ`: get the whole screen
+ * - `REMOTE_SUBSCRIBE`: 1 to get the changes after every frame, 0 to stop, answered with `REMOTE_ACK`
+ *
+ * Frames sent by the unit:
+ * - `REMOTE_SCREEN`: columns and rows, the rows and the cursor follow
+ * - `REMOTE_ROW`: index, `RemoteRowFlag`s, shift, length of the text, text, value
+ * - `REMOTE_CURSOR`: column, row, `RemoteCursorFlag`s
+ * - `REMOTE_DRAW`: column, row and a character drawn at the cursor, e.g. by `ItemInputCharset`
+ * - `REMOTE_ACK`: type of the acknowledged frame, number of processed commands or 1
+ */
+#define REMOTE_START 0xA5
+
+enum RemoteFrameType : uint8_t {
+    REMOTE_INPUT = 0x01,
+    REMOTE_READ = 0x02,
+    REMOTE_SUBSCRIBE = 0x03,
+    REMOTE_SCREEN = 0x80,
+    REMOTE_ROW = 0x81,
+    REMOTE_CURSOR = 0x82,
+    REMOTE_DRAW = 0x83,
+    REMOTE_ACK = 0x84,
+};
+
+enum RemoteRowFlag : uint8_t {
+    REMOTE_ROW_FOCUS = 1,
+    REMOTE_ROW_ABOVE = 2,
+    REMOTE_ROW_BELOW = 4,
+    REMOTE_ROW_VALUE = 8,
+    REMOTE_ROW_EDIT = 16,
+};
+
+enum RemoteCursorFlag : uint8_t {
+    REMOTE_CURSOR_BLINK = 1,
+    REMOTE_CURSOR_EDIT = 2,
+};
+
+/**
+ * @brief Update a CRC-16/CCITT-FALSE with a byte, start with 0xFFFF.
+ */
+inline uint16_t remoteCrc(uint16_t crc, uint8_t byte) {
+    crc ^= (uint16_t)byte << 8;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+        crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+    return crc;
+}
+
+/**
+ * @brief Writer of a frame straight to the stream, the payload is not buffered.
+ *
+ * ```
+ * RemoteFrameWriter frame(out, REMOTE_CURSOR, 3);
+ * frame.write(col);
+ * frame.write(row);
+ * frame.write(flags);
+ * frame.end();
+ * ```
+ */
+class RemoteFrameWriter {
+  protected:
+    Print& out;
+    uint16_t crc = 0xFFFF;
+
+  public:
+    /**
+     * @brief Write the header.
+     * @param length number of payload bytes which will be written, at most `REMOTE_PAYLOAD_SIZE`
+     */
+    RemoteFrameWriter(Print& out, uint8_t type, uint8_t length) : out(out) {
+        out.write(REMOTE_START);
+        write(type);
+        write(length);
+    }
+    void write(uint8_t byte) {
+        out.write(byte);
+        crc = remoteCrc(crc, byte);
+    }
+    void write(const char* text, uint8_t length) {
+        for (uint8_t i = 0; i < length; i++) {
+            write(text[i]);
+        }
+    }
+    /**
+     * @brief Write the CRC.
+     */
+    void end() {
+        out.write(crc & 0xFF);
+        out.write(crc >> 8);
+    }
+};
+
+/**
+ * @brief Decoder of frames, fed one byte at a time so frames may arrive in pieces.
+ */
+class RemoteFrameReader {
+  protected:
+    enum State : uint8_t { START, TYPE, LENGTH, PAYLOAD, CRC_LOW, CRC_HIGH };
+    State state = START;
+    uint8_t received = 0;
+    uint16_t crc = 0xFFFF;
+    uint8_t crcLow = 0;
+    uint16_t errors = 0;
+
+  public:
+    uint8_t type = 0;
+    uint8_t length = 0;
+    /**
+     * @brief Payload of the frame, valid once `feed` returned true.
+     */
+    uint8_t payload[REMOTE_PAYLOAD_SIZE];
+
+    /**
+     * @brief Decode the next byte.
+     * @return true if it completed a frame with the right CRC
+     */
+    bool feed(uint8_t byte) {
+        switch (state) {
+            case START:
+                if (byte == REMOTE_START) {
+                    crc = 0xFFFF;
+                    state = TYPE;
+                }
+                return false;
+            case TYPE:
+                type = byte;
+                crc = remoteCrc(crc, byte);
+                state = LENGTH;
+                return false;
+            case LENGTH:
+                if (byte > REMOTE_PAYLOAD_SIZE) {
+                    errors++;
+                    state = byte == REMOTE_START ? TYPE : START;
+                    crc = 0xFFFF;
+                    return false;
+                }
+                length = byte;
+                received = 0;
+                crc = remoteCrc(crc, byte);
+                state = length > 0 ? PAYLOAD : CRC_LOW;
+                return false;
+            case PAYLOAD:
+                payload[received++] = byte;
+                crc = remoteCrc(crc, byte);
+                if (received == length) {
+                    state = CRC_LOW;
+                }
+                return false;
+            case CRC_LOW:
+                crcLow = byte;
+                state = CRC_HIGH;
+                return false;
+            case CRC_HIGH:
+                state = START;
+                if ((uint16_t)(crcLow | (byte << 8)) != crc) {
+                    errors++;
+                    return false;
+                }
+                return true;
+        }
+        return false;
+    }
+    /**
+     * @brief Decode the next frame from a stream.
+     * @return true if a frame was read, false if the stream has no more bytes for now
+     */
+    bool read(Stream& in) {
+        while (in.available() > 0) {
+            if (feed(in.read())) {
+                return true;
+            }
+        }
+        return false;
+    }
+    /**
+     * @brief Number of frames dropped because of a wrong CRC or length.
+     */
+    uint16_t getErrors() const {
+        return errors;
+    }
+    /**
+     * @brief Drop a partially decoded frame.
+     */
+    void reset() {
+        state = START;
+    }
+};
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <mutex>
+
+/**
+ * @brief Lock for `UpdateQueue` shared between `std::thread`s.
+ *
+ * Meant for host builds and tests, and for cores providing the C++ standard
+ * thread library.
+ */
+class StdMutexLock {
+    std::mutex mutex;
+
+  public:
+    void lock() { mutex.lock(); }
+    void unlock() { mutex.unlock(); }
+};
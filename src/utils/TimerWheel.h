@@ -0,0 +1,174 @@
+#pragma once
+
+#include "constants.h"
+#include <Arduino.h>
+
+/**
+ * @brief Timer which can be scheduled on a `TimerWheel`.
+ *
+ * Deadlines are absolute times in milliseconds. They are compared by their
+ * distance to the current time, so they keep working when `millis()` wraps
+ * around, as long as they are less than 24 days away.
+ */
+class MenuTimer {
+    friend class TimerWheel;
+
+  private:
+    MenuTimer* next = NULL;
+    uint32_t deadline = 0;
+    /**
+     * @brief Slot the timer is listed in, the current one if it was overdue when scheduled.
+     */
+    uint8_t slot = 0;
+    bool armed = false;
+
+  protected:
+    /**
+     * @brief Called by `TimerWheel::poll` once the deadline passed, the timer may schedule itself again.
+     * @param now current time in milliseconds
+     */
+    virtual void fire(uint32_t now) = 0;
+
+  public:
+    virtual ~MenuTimer() = default;
+    /**
+     * @brief Check whether the timer is scheduled.
+     */
+    bool isArmed() const { return armed; }
+    /**
+     * @brief Get the time the timer fires at, only valid while it is armed.
+     */
+    uint32_t getDeadline() const { return deadline; }
+};
+
+/**
+ * @brief Timer calling a method of its owner.
+ * @tparam T type of the owner
+ *
+ * @example
+ *   BoundTimer<KeyboardAdapter> idleTimer{this, &KeyboardAdapter::onIdle};
+ */
+template <typename T>
+class BoundTimer : public MenuTimer {
+  protected:
+    T* owner;
+    void (T::*callback)(uint32_t now);
+
+    void fire(uint32_t now) override {
+        (owner->*callback)(now);
+    }
+
+  public:
+    BoundTimer(T* owner, void (T::*callback)(uint32_t now)) : owner(owner), callback(callback) {}
+};
+
+/**
+ * @brief Hashed timer wheel running timers from the main loop.
+ *
+ * Timers are kept in `TIMER_WHEEL_SLOTS` lists by the tick of their deadline,
+ * a tick being 2^`TIMER_WHEEL_RESOLUTION` milliseconds. `poll` only visits the
+ * lists of the ticks passed since the previous call, timers due in a later
+ * round of the wheel stay where they are.
+ *
+ * Timers are not owned by the wheel and must stay valid while armed.
+ * Everything runs in the task calling `poll`, timers are not task-safe.
+ */
+class TimerWheel {
+  protected:
+    MenuTimer* slots[TIMER_WHEEL_SLOTS] = {};
+    /**
+     * @brief Tick of the previous `poll`.
+     */
+    uint32_t lastTick = 0;
+
+    static uint8_t slotOf(uint32_t time) {
+        return (time >> TIMER_WHEEL_RESOLUTION) & (TIMER_WHEEL_SLOTS - 1);
+    }
+
+    static bool isDue(const MenuTimer* timer, uint32_t now) {
+        return (int32_t)(now - timer->deadline) >= 0;
+    }
+
+  public:
+    /**
+     * @brief Schedule a timer, a timer which is already armed is moved.
+     * @param timer the timer
+     * @param deadline time in milliseconds when the timer fires
+     */
+    void schedule(MenuTimer* timer, uint32_t deadline) {
+        cancel(timer);
+        // An overdue timer is due at the next poll, not when the wheel comes round to its tick again
+        bool overdue = (int32_t)(deadline - (lastTick << TIMER_WHEEL_RESOLUTION)) < 0;
+        uint8_t slot = overdue ? lastTick & (TIMER_WHEEL_SLOTS - 1) : slotOf(deadline);
+        timer->deadline = deadline;
+        timer->slot = slot;
+        timer->armed = true;
+        timer->next = slots[slot];
+        slots[slot] = timer;
+    }
+    /**
+     * @brief Remove a timer from the wheel, nothing happens if it isn't armed.
+     */
+    void cancel(MenuTimer* timer) {
+        if (!timer->armed) {
+            return;
+        }
+        MenuTimer** link = &slots[timer->slot];
+        while (*link != NULL && *link != timer) {
+            link = &(*link)->next;
+        }
+        if (*link == timer) {
+            *link = timer->next;
+        }
+        timer->next = NULL;
+        timer->armed = false;
+    }
+    /**
+     * @brief Fire all timers whose deadline passed.
+     * @param now current time in milliseconds
+     */
+    void poll(uint32_t now) {
+        uint32_t tick = now >> TIMER_WHEEL_RESOLUTION;
+        uint32_t ticks = tick - lastTick;
+        // Previous tick again, timers may have been added to it after the last poll
+        uint8_t count = ticks < TIMER_WHEEL_SLOTS ? ticks + 1 : TIMER_WHEEL_SLOTS;
+        lastTick = tick;
+        for (uint8_t i = 0; i < count; i++) {
+            uint8_t slot = (tick - i) & (TIMER_WHEEL_SLOTS - 1);
+            // Detach the list, timers may schedule themselves again while it is walked
+            MenuTimer* timer = slots[slot];
+            slots[slot] = NULL;
+            while (timer != NULL) {
+                MenuTimer* next = timer->next;
+                timer->next = NULL;
+                if (isDue(timer, now)) {
+                    timer->armed = false;
+                    timer->fire(now);
+                } else {
+                    // Back to the slot of its deadline, it may have been put into an earlier one as overdue
+                    timer->slot = slotOf(timer->deadline);
+                    timer->next = slots[timer->slot];
+                    slots[timer->slot] = timer;
+                }
+                timer = next;
+            }
+        }
+    }
+    /**
+     * @brief Get the earliest deadline of all armed timers.
+     * @param deadline set to the earliest deadline, or left untouched if no timer is armed
+     * @return true if any timer is armed
+     */
+    bool getNextDeadline(uint32_t& deadline) const {
+        bool found = false;
+        for (uint8_t slot = 0; slot < TIMER_WHEEL_SLOTS; slot++) {
+            for (MenuTimer* timer = slots[slot]; timer != NULL; timer = timer->next) {
+                if (!found || (int32_t)(timer->deadline - deadline) < 0) {
+                    deadline = timer->deadline;
+                    found = true;
+                }
+            }
+        }
+        return found;
+    }
+};
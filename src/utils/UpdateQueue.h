@@ -0,0 +1,140 @@
+#pragma once
+
+#include "ItemValue.h"
+
+/**
+ * @brief Interface of a queue of value updates drained by the task owning the menu.
+ * @see UpdateQueue
+ */
+class UpdateQueueInterface {
+  public:
+    /**
+     * @brief Apply all pending updates to their items.
+     * Must only be called from the task owning the menu, `LcdMenu::poll` does it for the attached queue.
+     * @return number of applied updates
+     */
+    virtual uint8_t drain() = 0;
+    /**
+     * @brief Check whether updates are waiting to be drained, can be called from any task.
+     */
+    virtual bool hasPending() = 0;
+};
+
+/**
+ * @brief Bounded queue of value updates which any task can post to.
+ *
+ * Other tasks must not draw on the display or modify items, as the display
+ * bus is not synchronised. Instead they post the new value of a `BaseItemValue`
+ * here, and the task owning the menu applies it in `LcdMenu::poll`, redrawing
+ * only the rows which changed.
+ *
+ * Posting never waits for the UI: the lock is only held while copying a
+ * single message. A pending update of the same item is overwritten, so a fast
+ * producer can't fill the queue with stale values.
+ *
+ * @tparam Lock lock guarding the queue, must provide `lock()` and `unlock()`,
+ *         e.g. `FreeRTOSLock` or `StdMutexLock`
+ * @tparam Capacity maximum number of pending updates of distinct items
+ *
+ * @example
+ *   UpdateQueue<FreeRTOSLock, 4> updates;
+ *   menu.setUpdateQueue(&updates);
+ *   // In another task
+ *   updates.post(statusItem, "Ready");  // BaseItemValue* statusItem = ITEM_VALUE("Status");
+ */
+template <typename Lock, uint8_t Capacity>
+class UpdateQueue : public UpdateQueueInterface {
+  protected:
+    struct Message {
+        BaseItemValue* item;
+        char value[ITEM_VALUE_BUFFER_SIZE];
+    };
+    Message messages[Capacity];
+    uint8_t head = 0;
+    uint8_t count = 0;
+    Lock lock;
+
+  public:
+    /**
+     * @brief Post a new value of an item, it is copied into the queue.
+     * Can be called from any task.
+     * @param item item to update, e.g. created with `ITEM_VALUE`
+     * @param value new value of the item
+     * @return false if the queue is full and the update was dropped
+     */
+    bool post(BaseItemValue* item, const char* value) {
+        bool posted = true;
+        lock.lock();
+        Message* message = find(item);
+        if (message == NULL && count < Capacity) {
+            message = &messages[(head + count) % Capacity];
+            message->item = item;
+            count++;
+        }
+        if (message != NULL) {
+            strncpy(message->value, value, ITEM_VALUE_BUFFER_SIZE - 1);
+            message->value[ITEM_VALUE_BUFFER_SIZE - 1] = '\0';
+        } else {
+            posted = false;
+        }
+        lock.unlock();
+        return posted;
+    }
+    /**
+     * @brief Format and post a new value of an item.
+     * Formatting happens in the calling task.
+     * @see post
+     */
+    template <typename T>
+    bool post(BaseItemValue* item, const char* format, T value) {
+        char formatted[ITEM_VALUE_BUFFER_SIZE];
+        snprintf(formatted, ITEM_VALUE_BUFFER_SIZE, format, value);
+        return post(item, formatted);
+    }
+
+    uint8_t drain() override {
+        uint8_t applied = 0;
+        Message message;
+        while (pop(message)) {
+            // Applied outside of the lock, so posting tasks don't wait for it
+            message.item->setValue(message.value);
+            applied++;
+        }
+        return applied;
+    }
+
+    bool hasPending() override {
+        lock.lock();
+        bool pending = count > 0;
+        lock.unlock();
+        return pending;
+    }
+
+  protected:
+    /**
+     * @brief Find pending message of an item, must be called with the lock held.
+     */
+    Message* find(BaseItemValue* item) {
+        for (uint8_t i = 0; i < count; i++) {
+            Message* message = &messages[(head + i) % Capacity];
+            if (message->item == item) {
+                return message;
+            }
+        }
+        return NULL;
+    }
+    /**
+     * @brief Take the oldest message out of the queue.
+     */
+    bool pop(Message& message) {
+        lock.lock();
+        bool popped = count > 0;
+        if (popped) {
+            message = messages[head];
+            head = (head + 1) % Capacity;
+            count--;
+        }
+        lock.unlock();
+        return popped;
+    }
+};
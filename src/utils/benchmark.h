@@ -0,0 +1,148 @@
+#pragma once
+
+#include "InputRecord.h"
+#include "LcdMenu.h"
+#include "constants.h"
+#include <Arduino.h>
+
+/**
+ * @brief Number of measured command kinds, see `benchmarkCommandIndex`.
+ */
+#define BENCHMARK_COMMANDS 9
+
+/**
+ * @brief Column of a command in the WCET table, all printable characters share the last one.
+ */
+inline uint8_t benchmarkCommandIndex(const unsigned char command) {
+    switch (command) {
+        case ENTER: return 0;
+        case BACK: return 1;
+        case UP: return 2;
+        case DOWN: return 3;
+        case LEFT: return 4;
+        case RIGHT: return 5;
+        case BACKSPACE: return 6;
+        case CLEAR: return 7;
+        default: return 8;
+    }
+}
+
+/**
+ * @brief Worst-case execution time table of `LcdMenu::process`, per item type and command.
+ *
+ * Each row is an item type under test. `run` sends commands to the menu and
+ * keeps the longest duration of every command kind. `report` prints the
+ * table and checks it against per command budgets.
+ *
+ * @tparam Rows number of item types under test
+ *
+ * @example
+ *   WcetBenchmark<2> benchmark(menu);
+ *   benchmark.setBudget(ENTER, 2000);
+ *   menu.setCursor(0);
+ *   benchmark.run(0, F("ItemInput"), script, sizeof(script));
+ *   bool passed = benchmark.report(Serial);
+ */
+template <uint8_t Rows>
+class WcetBenchmark {
+  protected:
+    LcdMenu& menu;
+    /**
+     * @brief Time source, `micros` by default.
+     */
+    unsigned long (*clock)();
+    const __FlashStringHelper* names[Rows] = {};
+    uint16_t worst[Rows][BENCHMARK_COMMANDS] = {};
+    /**
+     * @brief Budgets in clock ticks per command kind, `0` is unlimited.
+     */
+    uint16_t budgets[BENCHMARK_COMMANDS] = {};
+
+  public:
+    WcetBenchmark(LcdMenu& menu, unsigned long (*clock)() = micros) : menu(menu), clock(clock) {}
+    /**
+     * @brief Set the budget of a command kind for all item types.
+     * @param command the command, any printable character sets the budget of all of them
+     * @param budget maximum allowed duration in clock ticks, `0` is unlimited
+     */
+    void setBudget(const unsigned char command, uint16_t budget) {
+        budgets[benchmarkCommandIndex(command)] = budget;
+    }
+    /**
+     * @brief Process commands one by one and record their durations.
+     * Durations longer than `UINT16_MAX` ticks are saturated.
+     * @param row the row of the item type
+     * @param name the name of the item type
+     * @param commands the commands to send, in order
+     * @param count the number of commands
+     */
+    void run(uint8_t row, const __FlashStringHelper* name, const unsigned char* commands, uint8_t count) {
+        names[row] = name;
+        for (uint8_t i = 0; i < count; i++) {
+            measure(row, commands[i]);
+        }
+    }
+    /**
+     * @brief Process the commands of a recording made with `InputRecorder` and record their durations.
+     * The commands are sent back to back, the recorded delays are skipped.
+     * @param row the row of the workload
+     * @param name the name of the workload
+     * @param recording the records, read until the stream has no more bytes
+     * @return number of processed commands
+     */
+    uint16_t run(uint8_t row, const __FlashStringHelper* name, Stream& recording) {
+        names[row] = name;
+        InputRecordReader reader;
+        uint16_t count = 0;
+        while (reader.read(recording)) {
+            measure(row, reader.command);
+            count++;
+        }
+        return count;
+    }
+    /**
+     * @brief Process a command and keep its duration if it is the longest of its kind.
+     */
+    void measure(uint8_t row, const unsigned char command) {
+        unsigned long start = clock();
+        menu.process(command);
+        unsigned long duration = clock() - start;
+        uint16_t& slot = worst[row][benchmarkCommandIndex(command)];
+        if (duration > slot) {
+            slot = duration > UINT16_MAX ? UINT16_MAX : duration;
+        }
+    }
+    /**
+     * @brief Get the worst duration of a command kind of an item type.
+     */
+    uint16_t getWorst(uint8_t row, const unsigned char command) const {
+        return worst[row][benchmarkCommandIndex(command)];
+    }
+    /**
+     * @brief Print one line per item type with the worst durations, exceeded budgets are marked with `!`.
+     * The last line is `#BENCH# PASS` or `#BENCH# FAIL`.
+     * @return true if no budget was exceeded
+     */
+    bool report(Print& out) const {
+        static const char header[] PROGMEM = "ENTER BACK UP DOWN LEFT RIGHT BKSP CLEAR CHAR";
+        bool passed = true;
+        out.print(F("#BENCH# item "));
+        out.println((const __FlashStringHelper*)header);
+        for (uint8_t row = 0; row < Rows; row++) {
+            if (names[row] == NULL) continue;
+            out.print(F("#BENCH# "));
+            out.print(names[row]);
+            for (uint8_t i = 0; i < BENCHMARK_COMMANDS; i++) {
+                out.print(' ');
+                out.print(worst[row][i]);
+                if (budgets[i] != 0 && worst[row][i] > budgets[i]) {
+                    out.print('!');
+                    passed = false;
+                }
+            }
+            out.println();
+        }
+        out.println(passed ? F("#BENCH# PASS") : F("#BENCH# FAIL"));
+        return passed;
+    }
+};
@@ -21,4 +21,108 @@ typedef void (*fptrBool)(bool);
 //
 #ifndef DISPLAY_TIMEOUT
 #define DISPLAY_TIMEOUT 10000  // 10 seconds
-#endif
\ No newline at end of file
+#endif
+//
+// Type-ahead search configuration
+//
+/**
+ * @brief Time in milliseconds after which the type-ahead prefix is discarded.
+ *
+ * Printable characters typed within this interval are appended to the same
+ * prefix, after it a new search is started.
+ */
+#ifndef TYPE_AHEAD_TIMEOUT
+#define TYPE_AHEAD_TIMEOUT 1000
+#endif
+/**
+ * @brief Maximum length of the type-ahead prefix (including the terminating `\0`).
+ */
+#ifndef TYPE_AHEAD_BUFFER_SIZE
+#define TYPE_AHEAD_BUFFER_SIZE 8
+#endif
+/**
+ * @brief Maximum length of the filter of a screen (including the terminating `\0`).
+ */
+#ifndef FILTER_BUFFER_SIZE
+#define FILTER_BUFFER_SIZE 10
+#endif
+/**
+ * @brief Maximum length of the formatted value of `ItemValue` (including the terminating `\0`).
+ */
+#ifndef ITEM_VALUE_BUFFER_SIZE
+#define ITEM_VALUE_BUFFER_SIZE 12
+#endif
+/**
+ * @brief Number of events in the trace ring used by `LOG` when `DEBUG_TRACE` is defined.
+ * At most 256, one slot is kept free to tell a full ring from an empty one.
+ */
+#ifndef TRACE_BUFFER_SIZE
+#define TRACE_BUFFER_SIZE 32
+#endif
+/**
+ * @brief Number of power of two buckets of the latency histograms used when `DEBUG_LATENCY` is defined.
+ * The last bucket counts everything from 2^(LATENCY_BUCKETS - 1) microseconds on.
+ */
+#ifndef LATENCY_BUCKETS
+#define LATENCY_BUCKETS 16
+#endif
+/**
+ * @brief Character of a completely filled cell of `WidgetBar`, the full block in the ROM of HD44780 displays.
+ */
+#ifndef WIDGET_BAR_FULL
+#define WIDGET_BAR_FULL 0xFF
+#endif
+/**
+ * @brief Number of slots of the `TimerWheel` of `LcdMenu`, a power of two.
+ */
+#ifndef TIMER_WHEEL_SLOTS
+#define TIMER_WHEEL_SLOTS 8
+#endif
+/**
+ * @brief Length of a tick of the `TimerWheel` as a power of two milliseconds, 4 is 16ms.
+ */
+#ifndef TIMER_WHEEL_RESOLUTION
+#define TIMER_WHEEL_RESOLUTION 4
+#endif
+/**
+ * @brief Longest time in milliseconds `LcdMenu::poll` lets the loop wait, so sampled items stay fresh.
+ */
+#ifndef POLL_MAX_SLEEP
+#define POLL_MAX_SLEEP 1000
+#endif
+/**
+ * @brief Brightness of the backlight in the `DisplayPower::DIM` stage, 255 is full brightness.
+ */
+#ifndef DISPLAY_DIM_BRIGHTNESS
+#define DISPLAY_DIM_BRIGHTNESS 64
+#endif
+/**
+ * @brief Time in milliseconds `AnsiRenderer::begin` waits for the terminal to report its size.
+ */
+#ifndef ANSI_SIZE_TIMEOUT
+#define ANSI_SIZE_TIMEOUT 250
+#endif
+/**
+ * @brief Maximum number of renderers a `MirrorRenderer` shows the menu on, at most 8.
+ */
+#ifndef MIRROR_TARGETS
+#define MIRROR_TARGETS 3
+#endif
+/**
+ * @brief Number of bytes drawn at the cursor a `MirrorRenderer` keeps for a target until its budget allows a flush.
+ */
+#ifndef MIRROR_PENDING_DRAWS
+#define MIRROR_PENDING_DRAWS 4
+#endif
+/**
+ * @brief Largest payload of a frame of the remote protocol, see `RemoteFrame.h`.
+ */
+#ifndef REMOTE_PAYLOAD_SIZE
+#define REMOTE_PAYLOAD_SIZE 48
+#endif
+/**
+ * @brief Deepest nesting of screens `MenuIndex` follows, screens further down are not indexed.
+ */
+#ifndef MENU_INDEX_DEPTH
+#define MENU_INDEX_DEPTH 8
+#endif
@@ -0,0 +1,232 @@
+#pragma once
+
+#include "constants.h"
+#include <Arduino.h>
+
+/**
+ * @brief Measured stages of the path from an input event to the pixels on the display.
+ */
+enum LatencyStage : uint8_t {
+    LATENCY_OBSERVE,         ///< `InputInterface::observe` of the built-in adapters, when it passed a command to the menu
+    LATENCY_PROCESS,         ///< `LcdMenu::process`
+    LATENCY_DRAW,            ///< `MenuScreen::draw`
+    LATENCY_DRAW_ITEM,       ///< `MenuRenderer::drawItem` of the built-in renderers
+    LATENCY_FLUSH,           ///< `FrameBufferDisplay::flush`
+    LATENCY_INPUT_TO_GLASS,  ///< From start of `LcdMenu::process` until its frame is on the display
+    LATENCY_STAGES
+};
+
+/**
+ * @brief Histogram of durations in microseconds with fixed power of two buckets.
+ *
+ * Bucket `i` counts durations in [2^i, 2^(i+1)) us, the first one also counts
+ * `0` and the last one everything above. Minimum and maximum are exact,
+ * percentiles are the upper bound of the bucket they fall into.
+ */
+class LatencyHistogram {
+  protected:
+    uint16_t buckets[LATENCY_BUCKETS] = {};
+    uint16_t count = 0;
+    uint32_t minimum = UINT32_MAX;
+    uint32_t maximum = 0;
+
+  public:
+    /**
+     * @brief Add a duration, counters saturate instead of overflowing.
+     */
+    void record(uint32_t duration) {
+        uint8_t bucket = 0;
+        for (uint32_t bound = duration >> 1; bound > 0 && bucket < LATENCY_BUCKETS - 1; bound >>= 1) {
+            bucket++;
+        }
+        if (buckets[bucket] < UINT16_MAX) buckets[bucket]++;
+        if (count < UINT16_MAX) count++;
+        if (duration < minimum) minimum = duration;
+        if (duration > maximum) maximum = duration;
+    }
+    void reset() {
+        memset(buckets, 0, sizeof(buckets));
+        count = 0;
+        minimum = UINT32_MAX;
+        maximum = 0;
+    }
+    uint16_t getCount() const { return count; }
+    uint16_t getBucket(uint8_t bucket) const { return buckets[bucket]; }
+    uint32_t getMin() const { return count > 0 ? minimum : 0; }
+    uint32_t getMax() const { return maximum; }
+    /**
+     * @brief Get the upper bound of the given percentile in microseconds.
+     * @param percent percentile, e.g. `99`
+     */
+    uint32_t getPercentile(uint8_t percent) const {
+        // Rank of the sample, rounded up
+        uint32_t rank = ((uint32_t)count * percent + 99) / 100;
+        uint32_t seen = 0;
+        for (uint8_t i = 0; i < LATENCY_BUCKETS; i++) {
+            seen += buckets[i];
+            if (seen >= rank && seen > 0) {
+                uint32_t bound = i < LATENCY_BUCKETS - 1 ? ((uint32_t)2 << i) - 1 : maximum;
+                return bound < maximum ? bound : maximum;
+            }
+        }
+        return maximum;
+    }
+    /**
+     * @brief Print a summary line, e.g. `process n=150 min=380 p99=511 max=920 us`, followed by the bucket counts.
+     */
+    void print(Print& out, const __FlashStringHelper* name) const {
+        out.print(name);
+        out.print(F(" n="));
+        out.print(count);
+        out.print(F(" min="));
+        out.print(getMin());
+        out.print(F(" p99="));
+        out.print(getPercentile(99));
+        out.print(F(" max="));
+        out.print(maximum);
+        out.print(F(" us |"));
+        for (uint8_t i = 0; i < LATENCY_BUCKETS; i++) {
+            out.print(' ');
+            out.print(buckets[i]);
+        }
+        out.println();
+    }
+};
+
+/**
+ * @brief Histograms of all stages, shared by all translation units.
+ */
+inline LatencyHistogram* latencyHistograms() {
+    static LatencyHistogram histograms[LATENCY_STAGES];
+    return histograms;
+}
+
+/**
+ * @brief Get the histogram of a stage.
+ */
+inline LatencyHistogram& latencyHistogram(LatencyStage stage) {
+    return latencyHistograms()[stage];
+}
+
+/**
+ * @brief Start time of the input being processed and not yet on the display, `0` if none.
+ */
+inline uint32_t& latencyPendingInput() {
+    static uint32_t start = 0;
+    return start;
+}
+
+/**
+ * @brief Whether the adapter being observed passed a command to the menu, see `LatencyObserveScope`.
+ */
+inline bool& latencyCommandObserved() {
+    static bool observed = false;
+    return observed;
+}
+
+/**
+ * @brief Take the start time of the pending input, leaving none pending.
+ */
+inline uint32_t latencyTakeInput() {
+    uint32_t start = latencyPendingInput();
+    latencyPendingInput() = 0;
+    return start;
+}
+
+/**
+ * @brief Record the time since `start` into the input to glass histogram, if `start` is set.
+ */
+inline void latencyRecordGlass(uint32_t start) {
+    if (start != 0) {
+        latencyHistogram(LATENCY_INPUT_TO_GLASS).record(micros() - start);
+    }
+}
+
+/**
+ * @brief Print histograms of all stages.
+ */
+inline void latencyPrint(Print& out = Serial) {
+    latencyHistogram(LATENCY_OBSERVE).print(out, F("observe"));
+    latencyHistogram(LATENCY_PROCESS).print(out, F("process"));
+    latencyHistogram(LATENCY_DRAW).print(out, F("draw"));
+    latencyHistogram(LATENCY_DRAW_ITEM).print(out, F("drawItem"));
+    latencyHistogram(LATENCY_FLUSH).print(out, F("flush"));
+    latencyHistogram(LATENCY_INPUT_TO_GLASS).print(out, F("inputToGlass"));
+}
+
+/**
+ * @brief Clear histograms of all stages.
+ */
+inline void latencyReset() {
+    for (uint8_t i = 0; i < LATENCY_STAGES; i++) {
+        latencyHistograms()[i].reset();
+    }
+}
+
+/**
+ * @brief Records the lifetime of the scope into the histogram of a stage.
+ */
+class LatencyScope {
+    LatencyStage stage;
+    uint32_t start;
+
+  public:
+    explicit LatencyScope(LatencyStage stage) : stage(stage), start(micros()) {}
+    ~LatencyScope() {
+        latencyHistogram(stage).record(micros() - start);
+    }
+};
+
+/**
+ * @brief Records the lifetime of `observe` into the observe histogram, only if a command was passed to the menu.
+ * Idle polls would otherwise outnumber the observes which handle input by far.
+ */
+class LatencyObserveScope {
+    uint32_t start;
+
+  public:
+    LatencyObserveScope() : start(micros()) {
+        latencyCommandObserved() = false;
+    }
+    ~LatencyObserveScope() {
+        if (latencyCommandObserved()) {
+            latencyHistogram(LATENCY_OBSERVE).record(micros() - start);
+        }
+    }
+};
+
+#ifdef DEBUG_LATENCY
+#define LATENCY_CONCAT_(a, b) a##b
+#define LATENCY_CONCAT(a, b) LATENCY_CONCAT_(a, b)
+/**
+ * @brief Measure the rest of the enclosing scope as the given stage.
+ */
+#define LATENCY_SCOPE(stage) LatencyScope LATENCY_CONCAT(latencyScope, __LINE__)(stage)
+/**
+ * @brief Measure the rest of `observe` as `LATENCY_OBSERVE`, if it calls `LATENCY_COMMAND`.
+ */
+#define LATENCY_OBSERVE_SCOPE() LatencyObserveScope latencyObserveScope
+/**
+ * @brief Mark that the adapter being observed passed a command to the menu.
+ */
+#define LATENCY_COMMAND() (latencyCommandObserved() = true)
+/**
+ * @brief Mark the start of processing an input, unless an earlier one is still not on the display.
+ */
+#define LATENCY_INPUT()                           \
+    do {                                          \
+        if (latencyPendingInput() == 0) {         \
+            latencyPendingInput() = micros() | 1; \
+        }                                         \
+    } while (0)
+/**
+ * @brief Mark that everything drawn so far is on the display.
+ */
+#define LATENCY_GLASS() latencyRecordGlass(latencyTakeInput())
+#else
+#define LATENCY_SCOPE(stage)     // No-op
+#define LATENCY_OBSERVE_SCOPE()  // No-op
+#define LATENCY_COMMAND()        // No-op
+#define LATENCY_INPUT()          // No-op
+#define LATENCY_GLASS()          // No-op
+#endif
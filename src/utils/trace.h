@@ -0,0 +1,154 @@
+#pragma once
+
+#include "constants.h"
+#include <Arduino.h>
+
+/**
+ * @brief Single trace event as stored in the ring and sent over the wire.
+ */
+struct TraceEvent {
+    /**
+     * @brief Address of the `F()` string of the `LOG` call, `0` for the overflow marker.
+     */
+    uintptr_t id;
+    /**
+     * @brief Value of the `LOG` call, see `traceArg`.
+     */
+    uint16_t arg;
+    /**
+     * @brief Time of the event in microseconds.
+     */
+    uint32_t timestamp;
+};
+
+/**
+ * @brief Marker preceding each event on the wire, lets the decoder resynchronise.
+ */
+#define TRACE_SYNC 0xA5
+
+/**
+ * @brief RAM ring buffer of trace events.
+ *
+ * `LOG` calls only store a few bytes here, which is fast enough for hot
+ * paths. The ring is drained to a serial port with `flush` when there is
+ * time for it, e.g. at the end of the `loop` or from a low priority task.
+ * It is meant for a single producer (the task running the menu) and a single
+ * consumer calling `flush`. When the ring is full, new events are dropped and
+ * counted, the count is sent as an event with id `0`.
+ *
+ * Each event is sent as `TRACE_SYNC`, id, arg and timestamp in little-endian,
+ * the id has the size of a pointer of the target. `.scripts/trace_decode.py`
+ * maps the ids back to the `F()` strings using the firmware's ELF file.
+ */
+class TraceRing {
+  protected:
+    TraceEvent events[TRACE_BUFFER_SIZE];
+    volatile uint8_t head = 0;
+    volatile uint8_t tail = 0;
+    uint16_t dropped = 0;
+
+  public:
+    /**
+     * @brief Store an event, never blocks.
+     */
+    void record(const __FlashStringHelper* message, uint16_t arg) {
+        uint8_t next = (head + 1) % TRACE_BUFFER_SIZE;
+        if (next == tail) {
+            dropped++;
+            return;
+        }
+        TraceEvent& event = events[head];
+        event.id = (uintptr_t)message;
+        event.arg = arg;
+        event.timestamp = micros();
+        head = next;
+    }
+    /**
+     * @brief Send pending events as long as they fit into the output buffer without blocking.
+     * @param out the output, usually `Serial`
+     * @return number of sent events
+     */
+    uint8_t flush(Print& out) {
+        uint8_t sent = 0;
+        if (dropped > 0 && send(out, TraceEvent{0, dropped, (uint32_t)micros()})) {
+            dropped = 0;
+        }
+        while (tail != head && send(out, events[tail])) {
+            tail = (tail + 1) % TRACE_BUFFER_SIZE;
+            sent++;
+        }
+        return sent;
+    }
+
+  protected:
+    bool send(Print& out, const TraceEvent& event) {
+        if (out.availableForWrite() < (int)(1 + sizeof(uintptr_t) + 2 + 4)) {
+            return false;
+        }
+        out.write(TRACE_SYNC);
+        for (uint8_t i = 0; i < sizeof(uintptr_t); i++) {
+            out.write((uint8_t)(event.id >> (8 * i)));
+        }
+        out.write((uint8_t)event.arg);
+        out.write((uint8_t)(event.arg >> 8));
+        for (uint8_t i = 0; i < 4; i++) {
+            out.write((uint8_t)(event.timestamp >> (8 * i)));
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief Ring shared by all translation units.
+ */
+inline TraceRing& traceRing() {
+    static TraceRing ring;
+    return ring;
+}
+
+/**
+ * @brief Convert value of a `LOG` call to the 16 bit argument of the event.
+ * Integers are truncated to 16 bits.
+ */
+template <typename T>
+inline uint16_t traceArg(T value) {
+    return (uint16_t)value;
+}
+/**
+ * @brief Floats are recorded multiplied by 100.
+ */
+inline uint16_t traceArg(float value) {
+    return (uint16_t)(int16_t)(value * 100);
+}
+inline uint16_t traceArg(double value) {
+    return (uint16_t)(int16_t)(value * 100);
+}
+/**
+ * @brief Strings are recorded as their first two characters.
+ */
+inline uint16_t traceArg(const char* value) {
+    if (value == NULL || value[0] == '\0') {
+        return 0;
+    }
+    return (uint8_t)value[0] | ((uint8_t)value[1] << 8);
+}
+inline uint16_t traceArg(char* value) {
+    return traceArg((const char*)value);
+}
+
+inline void trace(const __FlashStringHelper* message) {
+    traceRing().record(message, 0);
+}
+
+template <typename T>
+inline void trace(const __FlashStringHelper* message, T value) {
+    traceRing().record(message, traceArg(value));
+}
+
+/**
+ * @brief Send recorded events to the output, call it when there is time for it.
+ * @see TraceRing::flush
+ */
+inline uint8_t traceFlush(Print& out = Serial) {
+    return traceRing().flush(out);
+}
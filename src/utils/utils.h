@@ -2,6 +2,8 @@
 #define MenuUtils_H
 
 #include "constants.h"
+#include "MenuClock.h"
+#include "latency.h"
 #include <Arduino.h>
 
 inline void substring(const char* str, uint8_t start, uint8_t size, char* substr) {
@@ -39,7 +41,29 @@ inline void remove(char* str, uint8_t index, uint8_t count) {
     memmove(str + index, str + index + count, len - count - index + 1);
 }
 
-#ifdef DEBUG
+inline bool containsIgnoreCase(const char* str, const char* pattern) {
+    if (*pattern == '\0') {
+        return true;
+    }
+    for (; *str; str++) {
+        const char* s = str;
+        const char* p = pattern;
+        while (*p && tolower(*s) == tolower(*p)) {
+            s++;
+            p++;
+        }
+        if (*p == '\0') {
+            return true;
+        }
+    }
+    return false;
+}
+
+#if defined(DEBUG_TRACE)
+// Binary events in a RAM ring, sent by `traceFlush`
+#include "trace.h"
+#define LOG(...) trace(__VA_ARGS__)
+#elif defined(DEBUG)
 #define LOG(...) log(__VA_ARGS__)
 inline void log(const __FlashStringHelper* command) {
     Serial.print(F("#LOG# "));
@@ -10,6 +10,7 @@
 #define ITEM_DRAW_BUFFER_SIZE 25
 
 class LcdMenu;
+class MenuRenderer;
 
 /**
  * @class BaseWidget
@@ -52,6 +53,18 @@ class BaseWidget {
      * @return the number of characters written into the buffer
      */
     virtual uint8_t draw(char* buffer, const uint8_t start = 0) = 0;
+    /**
+     * @brief Draw the widget into specified buffer for the row being drawn by `renderer`.
+     * Widgets showing custom glyphs request them here with `MenuRenderer::glyph`.
+     *
+     * @param renderer the renderer drawing the item
+     * @param buffer the buffer where widget will be drawn
+     * @param start the index where to start drawing in the buffer
+     * @return the number of characters written into the buffer
+     */
+    virtual uint8_t render(MenuRenderer* renderer, char* buffer, const uint8_t start) {
+        return draw(buffer, start);
+    }
 
   public:
     virtual ~BaseWidget() = default;
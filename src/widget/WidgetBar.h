@@ -0,0 +1,123 @@
+#pragma once
+
+#include "WidgetRange.h"
+#include "renderer/MenuRenderer.h"
+
+/**
+ * @brief Glyph of a cell filled up to `columns` of its 5 pixel columns, from the left.
+ * @param columns filled columns, 1 to 4
+ */
+inline const uint8_t* barGlyph(uint8_t columns) {
+    static const uint8_t glyphs[4][8] = {
+        {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10},
+        {0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18},
+        {0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C},
+        {0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E},
+    };
+    return glyphs[columns - 1];
+}
+
+/**
+ * @class WidgetBar
+ * @brief Widget showing a value of a range as a horizontal bar.
+ *
+ * Each cell of the bar has 5 steps, one per pixel column. Full and empty cells
+ * are plain characters, only the partially filled cell at the end of the bar
+ * needs a custom glyph, so the bar never uses more than one glyph slot.
+ * The value is changed like the value of `WidgetRange`.
+ *
+ * ```
+ * ┌────────────────────────────┐
+ * │ > T A N K : █ █ █ ▌        │
+ * └────────────────────────────┘
+ * ```
+ */
+template <typename T>
+class WidgetBar : public WidgetRange<T> {
+  protected:
+    /**
+     * @brief Number of cells of the bar.
+     */
+    const uint8_t width;
+
+  public:
+    WidgetBar(
+        const T& value,
+        const T step,
+        const T min,
+        const T max,
+        const uint8_t width,
+        const char* format = "%s",
+        const uint8_t cursorOffset = 0,
+        const bool cycle = false,
+        void (*callback)(const T&) = nullptr)
+        : WidgetRange<T>(value, step, min, max, format, cursorOffset, cycle, callback),
+          width(width < ITEM_DRAW_BUFFER_SIZE ? width : ITEM_DRAW_BUFFER_SIZE - 1) {}
+    /**
+     * @brief Get the filled length of the bar in pixel columns, 5 per cell.
+     * A bar with an empty range is full.
+     */
+    uint8_t getFill() const {
+        if (this->maxValue == this->minValue) {
+            return width * 5;
+        }
+        float ratio = (float)(this->value - this->minValue) / (this->maxValue - this->minValue);
+        return (uint8_t)(ratio * width * 5 + 0.5f);
+    }
+
+  protected:
+    uint8_t render(MenuRenderer* renderer, char* buffer, const uint8_t start) override {
+        if (start >= ITEM_DRAW_BUFFER_SIZE) return 0;
+        char bar[ITEM_DRAW_BUFFER_SIZE];
+        uint8_t fill = getFill();
+        for (uint8_t i = 0; i < width; i++) {
+            uint8_t columns = fill > i * 5 ? fill - i * 5 : 0;
+            if (columns == 0) {
+                bar[i] = ' ';
+            } else if (columns >= 5) {
+                bar[i] = (char)WIDGET_BAR_FULL;
+            } else {
+                // Without a free slot round to the nearest plain cell
+                uint8_t fallback = columns >= 3 ? WIDGET_BAR_FULL : ' ';
+                bar[i] = (char)(renderer != NULL ? renderer->glyph(barGlyph(columns), fallback) : fallback);
+            }
+        }
+        bar[width] = '\0';
+        return snprintf(buffer + start, ITEM_DRAW_BUFFER_SIZE - start, this->format, bar);
+    }
+
+    uint8_t draw(char* buffer, const uint8_t start) override {
+        return render(NULL, buffer, start);
+    }
+};
+
+/**
+ * @brief Function to create a new WidgetBar<T> instance.
+ * @tparam T The type of the value.
+ *
+ * @param value The initial value of the widget.
+ * @param step The step value for incrementing/decrementing.
+ * @param min The value of an empty bar.
+ * @param max The value of a full bar.
+ * @param width The number of cells of the bar.
+ * @param format The format string for displaying the bar (default is "%s").
+ * @param cursorOffset The offset for the cursor (default is 0).
+ * @param cycle Whether the value should cycle when out of range (default is false).
+ * @param callback The callback function to call when the value changes (default is nullptr).
+ *
+ * @example
+ *   WIDGET_BAR(40, 5, 0, 100, 8)
+ */
+template <typename T>
+inline BaseWidgetValue<T>* WIDGET_BAR(
+    T value,
+    T step,
+    T min,
+    T max,
+    uint8_t width,
+    const char* format = "%s",
+    uint8_t cursorOffset = 0,
+    bool cycle = false,
+    void (*callback)(const T&) = nullptr) {
+    return new WidgetBar<T>(value, step, min, max, width, format, cursorOffset, cycle, callback);
+}
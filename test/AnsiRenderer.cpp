@@ -0,0 +1,232 @@
+#include "fixtures.h"
+#include <ArduinoUnitTests.h>
+#include <ItemInput.h>
+#include <LcdMenu.h>
+#include <MenuScreen.h>
+#include <renderer/AnsiRenderer.h>
+#include <string>
+
+#define TERM_COLS 20
+#define TERM_ROWS 3
+
+ManualClock virtualClock;
+
+/**
+ * Terminal understanding the sequences written by the renderer, cells hold UTF-8 characters.
+ */
+class Terminal : public Stream {
+  public:
+    std::string answer;
+    std::string sent;
+    std::string cells[TERM_ROWS][TERM_COLS];
+    bool reverse[TERM_ROWS][TERM_COLS];
+    bool underline[TERM_ROWS][TERM_COLS];
+    int col = 0;
+    int row = 0;
+    bool cursorVisible = false;
+    bool inReverse = false;
+    bool inUnderline = false;
+    std::string sequence;
+    size_t pending = 0;
+
+    void reset() {
+        answer.clear();
+        sent.clear();
+        clear();
+    }
+    void clear() {
+        for (int r = 0; r < TERM_ROWS; r++) {
+            for (int c = 0; c < TERM_COLS; c++) {
+                cells[r][c] = " ";
+                reverse[r][c] = false;
+                underline[r][c] = false;
+            }
+        }
+    }
+    std::string line(int r) {
+        std::string text;
+        for (int c = 0; c < TERM_COLS; c++) text += cells[r][c];
+        return text;
+    }
+    int available() override {
+        // Time goes by while the renderer waits for an answer
+        if (answer.empty()) virtualClock.advance(10);
+        return answer.size();
+    }
+    int read() override {
+        if (answer.empty()) return -1;
+        int c = (uint8_t)answer[0];
+        answer.erase(0, 1);
+        return c;
+    }
+    int peek() override { return answer.empty() ? -1 : (uint8_t)answer[0]; }
+    size_t write(uint8_t byte) override {
+        sent += (char)byte;
+        if (!sequence.empty()) {
+            sequence += (char)byte;
+            if (sequence.size() > 1 && byte >= 0x40 && byte != '[') execute();
+            return 1;
+        }
+        if (byte == 0x1B) {
+            sequence += (char)byte;
+            return 1;
+        }
+        if (pending > 0) {
+            cells[row][col - 1] += (char)byte;
+            pending--;
+            return 1;
+        }
+        if (col < TERM_COLS && row < TERM_ROWS) {
+            cells[row][col] = std::string(1, (char)byte);
+            reverse[row][col] = inReverse;
+            underline[row][col] = inUnderline;
+        }
+        pending = byte >= 0xF0 ? 3 : byte >= 0xE0 ? 2 : byte >= 0xC0 ? 1 : 0;
+        if (col < TERM_COLS) col++;
+        return 1;
+    }
+    void execute() {
+        std::string params = sequence.substr(2, sequence.size() - 3);
+        char command = sequence.back();
+        sequence.clear();
+        if (command == 'H') {
+            int r = 1, c = 1;
+            sscanf(params.c_str(), "%d;%d", &r, &c);
+            row = min(r, TERM_ROWS) - 1;
+            col = min(c, TERM_COLS) - 1;
+        } else if (command == 'J') {
+            clear();
+        } else if (command == 'm') {
+            inReverse = params.find('7') != std::string::npos;
+            inUnderline = params.find('4') != std::string::npos;
+        } else if (command == 'h' && params == "?25") {
+            cursorVisible = true;
+        } else if (command == 'l' && params == "?25") {
+            cursorVisible = false;
+        } else if (command == 'n' && params == "6") {
+            answer += "\x1B[" + std::to_string(TERM_ROWS) + ";" + std::to_string(TERM_COLS) + "R";
+        }
+    }
+};
+
+// clang-format off
+MENU_SCREEN(mainScreen, mainItems,
+    ITEM_BASIC("Start service"),
+    ITEM_INPUT("Name", [](char* value) {}),
+    ITEM_BASIC("Settings"),
+    ITEM_BASIC("Blink SOS"));
+// clang-format on
+
+Terminal terminal;
+AnsiRenderer renderer(&terminal, 40, 8);
+LcdMenu menu(renderer);
+
+void start() {
+    setMenuClock(&virtualClock);
+    terminal.reset();
+    startMenu(renderer, menu, mainScreen);
+}
+
+unittest(uses_reported_terminal_size) {
+    start();
+    assertEqual(TERM_COLS, renderer.getMaxCols());
+    assertEqual(TERM_ROWS, renderer.getMaxRows());
+}
+
+unittest(keeps_size_without_answer) {
+    setMenuClock(&virtualClock);
+    Terminal silent;
+    AnsiRenderer other(&silent, 16, 2);
+    // Answer of another terminal is dropped, keys typed before it are skipped
+    silent.answer = "x\x1B[5";
+    other.begin();
+    assertEqual(16, other.getMaxCols());
+    assertEqual(2, other.getMaxRows());
+    silent.answer = "ab\x1B[9;12R";
+    other.begin();
+    assertEqual(12, other.getMaxCols());
+    assertEqual(2, other.getMaxRows());
+}
+
+unittest(focus_is_reverse_video) {
+    start();
+    assertEqual("Start service      \xE2\x94\x82", terminal.line(0));
+    assertEqual("Name:              \xE2\x94\x82", terminal.line(1));
+    assertEqual("Settings           \xE2\x95\xBD", terminal.line(2));
+    assertTrue(terminal.reverse[0][0]);
+    assertTrue(terminal.reverse[0][18]);
+    assertFalse(terminal.reverse[0][19]);
+    assertFalse(terminal.reverse[1][0]);
+    assertFalse(terminal.cursorVisible);
+}
+
+unittest(moving_focus_only_rewrites_attributes) {
+    start();
+    terminal.sent.clear();
+    menu.process(DOWN);
+    assertFalse(terminal.reverse[0][0]);
+    assertTrue(terminal.reverse[1][0]);
+    // Both rows are written again with their new attribute, nothing else
+    assertEqual(
+        "\x1B[1;1HStart service      "
+        "\x1B[2;1H\x1B[0;7mName:              ",
+        terminal.sent);
+}
+
+unittest(scrolling_writes_changed_cells) {
+    start();
+    menu.process(DOWN);
+    menu.process(DOWN);
+    terminal.sent.clear();
+    menu.process(DOWN);
+    assertEqual("Name:              \xE2\x95\xBF", terminal.line(0));
+    assertEqual("Settings           \xE2\x94\x82", terminal.line(1));
+    assertEqual("Blink SOS          \xE2\x94\x82", terminal.line(2));
+    assertTrue(terminal.reverse[2][0]);
+    // Only the cells which changed, the focused row keeps its attribute
+    assertEqual(
+        "\x1B[1;1H\x1B[0mName:        \x1B[1;20H\xE2\x95\xBF"
+        "\x1B[2;1HSettings"
+        "\x1B[3;1H\x1B[0;7mBlink SOS"
+        "\x1B[3;20H\x1B[0m\xE2\x94\x82",
+        terminal.sent);
+}
+
+unittest(edit_mode_shows_cursor_and_underline) {
+    start();
+    menu.process(DOWN);
+    menu.process(ENTER);
+    assertTrue(terminal.cursorVisible);
+    assertTrue(terminal.underline[1][0]);
+    assertEqual(1, terminal.row);
+    assertEqual(5, terminal.col);
+    menu.process(BACK);
+    assertFalse(terminal.cursorVisible);
+    assertFalse(terminal.underline[1][0]);
+}
+
+unittest(wake_up_repaints_cleared_terminal) {
+    start();
+    renderer.setTimeout(1000);
+    virtualClock.advance(1000);
+    menu.poll();
+    assertEqual(DisplayPower::OFF, renderer.getPower());
+    assertEqual(std::string(TERM_COLS, ' '), terminal.line(0));
+    menu.process(DOWN);
+    assertEqual("Start service      \xE2\x94\x82", terminal.line(0));
+    assertTrue(terminal.reverse[1][0]);
+    renderer.setTimeout(0);
+}
+
+unittest(other_bytes_are_replaced) {
+    start();
+    renderer.invalidate();
+    menu.refresh();
+    terminal.sent.clear();
+    renderer.moveCursor(2, 2);
+    renderer.draw(0xFF);
+    renderer.draw(0x01);
+    assertEqual("\x1B[3;3H\xE2\x96\x88?", terminal.sent);
+}
+
+unittest_main()
@@ -0,0 +1,76 @@
+#include "fixtures.h"
+#include <ArduinoUnitTests.h>
+#include <ItemSubMenu.h>
+#include <ItemToggle.h>
+#include <LcdMenu.h>
+#include <MenuScreen.h>
+#include <renderer/CharacterDisplayRenderer.h>
+#include <utils/benchmark.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+#define ROWS 3
+
+extern MenuScreen* subScreen;
+
+// clang-format off
+MENU_SCREEN(mainScreen, mainItems,
+    ITEM_BASIC("Basic"),
+    ITEM_TOGGLE("Toggle", [](bool isOn) {}),
+    ITEM_SUBMENU("Submenu", subScreen));
+
+MENU_SCREEN(subScreen, subItems,
+    ITEM_BASIC("Bottom"));
+// clang-format on
+
+const unsigned char editScript[] = {UP, DOWN, ENTER, ENTER, LEFT, RIGHT, 'z', BACKSPACE, CLEAR};
+const unsigned char submenuScript[] = {ENTER, UP, DOWN, BACK};
+
+CharacterDisplayRenderer renderer(new NullDisplay(), LCD_COLS, LCD_ROWS);
+LcdMenu menu(renderer);
+
+// Every command takes exactly 5 ticks
+unsigned long ticks = 0;
+unsigned long tick() {
+    return ticks += 5;
+}
+
+void runScripts(WcetBenchmark<ROWS>& benchmark) {
+    menu.setScreen(mainScreen);
+    menu.setCursor(0);
+    benchmark.run(0, F("ItemBasic"), editScript, sizeof(editScript));
+    menu.setCursor(1);
+    benchmark.run(1, F("ItemToggle"), editScript, sizeof(editScript));
+    menu.setScreen(mainScreen);
+    menu.setCursor(2);
+    benchmark.run(2, F("ItemSubMenu"), submenuScript, sizeof(submenuScript));
+}
+
+unittest(benchmark_records_every_command) {
+    WcetBenchmark<ROWS> benchmark(menu, tick);
+    runScripts(benchmark);
+    assertEqual(5, benchmark.getWorst(0, 'z'));
+    assertEqual(5, benchmark.getWorst(2, BACK));
+    assertEqual(0, benchmark.getWorst(0, BACK));
+    assertTrue(benchmark.report(Serial));
+}
+
+unittest(benchmark_fails_over_budget) {
+    WcetBenchmark<ROWS> benchmark(menu, tick);
+    benchmark.setBudget(ENTER, 5);
+    runScripts(benchmark);
+    assertTrue(benchmark.report(Serial));
+    benchmark.setBudget('a', 4);
+    assertFalse(benchmark.report(Serial));
+}
+
+unittest(benchmark_leaves_menu_usable) {
+    WcetBenchmark<ROWS> benchmark(menu, tick);
+    runScripts(benchmark);
+    // BACK of the script returned to the main screen
+    assertEqual(mainScreen, menu.getScreen());
+    assertEqual(2, menu.getCursor());
+    assertFalse(menu.getRenderer()->isInEditMode());
+}
+
+unittest_main()
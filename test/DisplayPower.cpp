@@ -0,0 +1,115 @@
+#include "fixtures.h"
+#include <ArduinoUnitTests.h>
+#include <LcdMenu.h>
+#include <MenuScreen.h>
+#include <renderer/CharacterDisplayRenderer.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+// clang-format off
+MENU_SCREEN(mainScreen, mainItems,
+    ITEM_BASIC("Start service"),
+    ITEM_BASIC("Settings"),
+    ITEM_BASIC("Blink SOS"));
+// clang-format on
+
+PowerDisplay display;
+CharacterDisplayRenderer renderer(&display, LCD_COLS, LCD_ROWS);
+LcdMenu menu(renderer);
+
+void advance(unsigned long ms) {
+    GODMODE()->micros += ms * 1000;
+    menu.poll();
+}
+
+unittest(enters_stages_in_order) {
+    renderer.begin();
+    renderer.setPowerTimeouts(1000, 3000, 6000);
+    menu.setScreen(mainScreen);
+    menu.reset();
+    display.commands = 0;
+    advance(999);
+    assertEqual(DisplayPower::ON, renderer.getPower());
+    advance(1);
+    assertEqual(DisplayPower::DIM, renderer.getPower());
+    assertEqual(DISPLAY_DIM_BRIGHTNESS, display.brightness);
+    advance(2000);
+    assertEqual(DisplayPower::BACKLIGHT_OFF, renderer.getPower());
+    assertEqual(0, display.brightness);
+    assertTrue(display.visible);
+    advance(3000);
+    assertEqual(DisplayPower::OFF, renderer.getPower());
+    assertFalse(display.visible);
+    assertEqual(3, display.commands);
+    renderer.setPowerTimeouts(0, 0, 0);
+}
+
+unittest(sends_commands_only_on_transitions) {
+    renderer.begin();
+    renderer.setPowerTimeouts(1000, 0, 5000);
+    menu.setScreen(mainScreen);
+    menu.reset();
+    display.commands = 0;
+    menu.process(DOWN);
+    menu.process(DOWN);
+    advance(500);
+    assertEqual(0, display.commands);
+    advance(600);
+    assertEqual(1, display.commands);
+    // Waking up restores the brightness once, the next keys send nothing
+    menu.process(UP);
+    assertEqual(255, display.brightness);
+    menu.process(UP);
+    assertEqual(2, display.commands);
+    assertEqual(0, menu.getCursor());
+    renderer.setPowerTimeouts(0, 0, 0);
+}
+
+unittest(skipped_polls_enter_all_passed_stages) {
+    renderer.begin();
+    renderer.setPowerTimeouts(1000, 2000, 3000);
+    menu.setScreen(mainScreen);
+    menu.reset();
+    display.commands = 0;
+    advance(10000);
+    assertEqual(DisplayPower::OFF, renderer.getPower());
+    assertEqual(1, display.commands);
+    menu.process(DOWN);
+    assertTrue(display.visible);
+    assertEqual(255, display.brightness);
+    renderer.setPowerTimeouts(0, 0, 0);
+}
+
+unittest(wake_key_is_consumed) {
+    renderer.begin();
+    renderer.setPowerTimeouts(0, 0, 1000);
+    menu.setScreen(mainScreen);
+    menu.reset();
+    menu.setConsumeWakeKey(true);
+    advance(1000);
+    assertFalse(display.visible);
+    assertTrue(menu.process(DOWN));
+    assertTrue(display.visible);
+    assertEqual(0, menu.getCursor());
+    menu.process(DOWN);
+    assertEqual(1, menu.getCursor());
+    // Dimmed is still readable, keys are processed
+    renderer.setPowerTimeouts(1000, 0, 0);
+    advance(1000);
+    menu.process(DOWN);
+    assertEqual(2, menu.getCursor());
+    menu.setConsumeWakeKey(false);
+    renderer.setPowerTimeouts(0, 0, 0);
+}
+
+unittest(update_timer_without_timeouts_uses_display_timeout) {
+    startMenu(renderer, menu, mainScreen);
+    GODMODE()->micros += (DISPLAY_TIMEOUT + 5) * 1000UL;
+    renderer.updateTimer();
+    assertFalse(display.visible);
+    menu.process(DOWN);
+    assertTrue(display.visible);
+}
+
+unittest_main()
@@ -0,0 +1,122 @@
+#include <ArduinoUnitTests.h>
+#include <LcdMenu.h>
+#include <MenuScreen.h>
+#include <display/FrameBufferDisplay.h>
+#include <renderer/CharacterDisplayRenderer.h>
+#include <atomic>
+#include <thread>
+#include <utils/StdMutexLock.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+class PanelDisplay : public CharacterDisplayInterface {
+  public:
+    CharacterFrame frame;
+    uint16_t writes = 0;
+    /**
+     * Whether the address points to CGRAM, like the HD44780 after `createChar`.
+     */
+    bool inGlyphs = false;
+    void begin() override { frame.begin(LCD_COLS, LCD_ROWS); }
+    void clear() override { frame.clear(); }
+    void show() override {}
+    void hide() override {}
+    void draw(uint8_t byte) override {
+        frame.draw(byte);
+        writes++;
+    }
+    void draw(const char* text) override {
+        while (*text) draw(*text++);
+    }
+    void setCursor(uint8_t col, uint8_t row) override {
+        inGlyphs = false;
+        frame.cursorCol = col;
+        frame.cursorRow = row;
+    }
+    void setBacklight(bool enabled) override {}
+    void createChar(uint8_t id, uint8_t* c) override { inGlyphs = true; }
+    void drawBlinker() override {}
+    void clearBlinker() override {}
+};
+
+// clang-format off
+MENU_SCREEN(mainScreen, mainItems,
+    ITEM_BASIC("Item 1"),
+    ITEM_BASIC("Item 2"),
+    ITEM_BASIC("Item 3"),
+    ITEM_BASIC("Item 4"));
+// clang-format on
+
+PanelDisplay panel;
+FrameBufferDisplay<StdMutexLock> frameBuffer(&panel, LCD_COLS, LCD_ROWS);
+CharacterDisplayRenderer renderer(&frameBuffer, LCD_COLS, LCD_ROWS);
+LcdMenu menu(renderer);
+
+unittest(flush_writes_only_changed_cells) {
+    renderer.begin();
+    menu.setScreen(mainScreen);
+    assertEqual(0, panel.writes);
+    assertTrue(frameBuffer.flush());
+    assertEqual('I', panel.frame.at(1, 0));
+    assertFalse(frameBuffer.flush());
+    panel.writes = 0;
+    menu.process(DOWN);
+    assertTrue(frameBuffer.flush());
+    // Only the cursor icons of both rows changed
+    assertEqual(2, panel.writes);
+    assertEqual(' ', panel.frame.at(0, 0));
+}
+
+unittest(glyph_upload_restores_cursor) {
+    renderer.begin();
+    menu.setScreen(mainScreen);
+    frameBuffer.flush();
+    uint8_t glyph[8] = {0};
+    frameBuffer.createChar(0, glyph);
+    // No frame was committed, the glyph is uploaded alone
+    assertFalse(frameBuffer.flush());
+    assertFalse(panel.inGlyphs);
+}
+
+unittest(frame_grows_its_cells) {
+    CharacterFrame frame;
+    frame.begin(2, 1);
+    frame.begin(LCD_COLS, LCD_ROWS);
+    frame.cursorCol = LCD_COLS - 1;
+    frame.cursorRow = LCD_ROWS - 1;
+    frame.draw('x');
+    assertEqual('x', frame.at(LCD_COLS - 1, LCD_ROWS - 1));
+    assertEqual(' ', frame.at(0, 0));
+}
+
+unittest(slow_panel_drops_frames) {
+    uint16_t dropped = frameBuffer.getDroppedFrames();
+    menu.process(DOWN);
+    menu.process(DOWN);
+    menu.process(UP);
+    assertEqual(dropped + 2, frameBuffer.getDroppedFrames());
+    assertTrue(frameBuffer.flush());
+    assertEqual('3', panel.frame.at(6, 0));
+    assertEqual('4', panel.frame.at(6, 1));
+}
+
+unittest(render_thread_shows_latest_frame) {
+    std::atomic<bool> running(true);
+    std::thread renderTask([&running]() {
+        while (running) {
+            frameBuffer.flush();
+        }
+    });
+    for (uint8_t i = 0; i < 100; i++) {
+        menu.process(i % 2 ? UP : DOWN);
+    }
+    menu.process(DOWN);
+    running = false;
+    renderTask.join();
+    frameBuffer.flush();
+    assertEqual('3', panel.frame.at(6, 0));
+    assertEqual('4', panel.frame.at(6, 1));
+}
+
+unittest_main()
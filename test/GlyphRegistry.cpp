@@ -0,0 +1,187 @@
+#include <ArduinoUnitTests.h>
+#include <ItemTrend.h>
+#include <ItemWidget.h>
+#include <LcdMenu.h>
+#include <MenuScreen.h>
+#include <display/GlyphRegistry.h>
+#include <renderer/CharacterDisplayRenderer.h>
+#include <widget/WidgetBar.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+class GlyphDisplay : public CharacterDisplayInterface {
+  public:
+    uint8_t uploads = 0;
+    uint16_t writes = 0;
+    uint8_t* slots[8] = {};
+    void begin() override {}
+    void clear() override {}
+    void show() override {}
+    void hide() override {}
+    void draw(uint8_t byte) override { writes++; }
+    void draw(const char* text) override {}
+    void setCursor(uint8_t col, uint8_t row) override {}
+    void setBacklight(bool enabled) override {}
+    void createChar(uint8_t id, uint8_t* c) override {
+        slots[id] = c;
+        uploads++;
+    }
+    void drawBlinker() override {}
+    void clearBlinker() override {}
+};
+
+class ItemIcon : public MenuItem {
+  public:
+    const uint8_t* icon;
+    uint8_t drawn = 0;
+    ItemIcon(const char* text, const uint8_t* icon) : MenuItem(text), icon(icon) {}
+
+  protected:
+    void draw(MenuRenderer* renderer) override {
+        drawn = renderer->glyph(icon, '*');
+        char value[] = {(char)drawn, '\0'};
+        renderer->drawItem(text, value);
+    }
+};
+
+uint8_t glyphs[8][8] = {};
+
+// clang-format off
+MENU_SCREEN(iconScreen, iconItems,
+    new ItemIcon("Icon 0", glyphs[0]),
+    new ItemIcon("Icon 1", glyphs[1]),
+    new ItemIcon("Icon 2", glyphs[2]),
+    new ItemIcon("Icon 3", glyphs[0]));
+
+MENU_SCREEN(trendScreen, trendItems,
+    ITEM_TREND<10>("Trend", 0, 8));
+
+MENU_SCREEN(barScreen, barItems,
+    ITEM_WIDGET("Bar", [](int level) {}, WIDGET_BAR(0, 1, 0, 40, 8)));
+// clang-format on
+
+GlyphDisplay display;
+
+unittest(resident_glyph_is_not_uploaded_again) {
+    GlyphRegistry registry(LCD_ROWS);
+    assertEqual(1, registry.use(glyphs[0]));
+    registry.endRow(0, 0x02);
+    assertTrue(registry.upload(&display));
+    assertEqual(1, registry.use(glyphs[0]));
+    registry.endRow(0, 0x02);
+    assertFalse(registry.upload(&display));
+    assertEqual(1, registry.getRefCount(glyphs[0]));
+}
+
+unittest(least_recently_used_glyph_is_evicted) {
+    GlyphRegistry registry(LCD_ROWS, 6);
+    registry.use(glyphs[0]);
+    registry.use(glyphs[1]);
+    // Row shows something else, both glyphs are unpinned
+    registry.endRow(0, 0);
+    registry.use(glyphs[0]);
+    registry.endRow(1, 0);
+    assertEqual(7, registry.use(glyphs[2]));
+    assertTrue(registry.isResident(glyphs[0]));
+    assertFalse(registry.isResident(glyphs[1]));
+}
+
+unittest(glyphs_on_visible_rows_are_pinned) {
+    GlyphRegistry registry(LCD_ROWS, 6);
+    assertEqual(6, registry.use(glyphs[0]));
+    registry.endRow(0, 0x40);
+    assertEqual(7, registry.use(glyphs[1]));
+    registry.endRow(1, 0x80);
+    assertEqual(0, registry.use(glyphs[2]));
+    assertEqual(1, registry.getRefCount(glyphs[1]));
+}
+
+unittest(renderer_uploads_glyphs_of_visible_rows) {
+    CharacterDisplayRenderer renderer(&display, LCD_COLS, LCD_ROWS);
+    LcdMenu menu(renderer);
+    renderer.begin();
+    display.uploads = 0;
+    menu.setScreen(iconScreen);
+    assertEqual(2, display.uploads);
+    assertEqual(glyphs[0], display.slots[2]);
+    assertEqual(2, static_cast<ItemIcon*>(iconItems[0])->drawn);
+    // Scrolling to the last row reuses the resident glyph
+    menu.process(DOWN);
+    menu.process(DOWN);
+    menu.process(DOWN);
+    assertEqual(3, display.uploads);
+    assertEqual(2, static_cast<ItemIcon*>(iconItems[3])->drawn);
+}
+
+unittest(bar_writes_only_changed_cells) {
+    CharacterDisplayRenderer renderer(&display, LCD_COLS, LCD_ROWS);
+    LcdMenu menu(renderer);
+    renderer.begin();
+    menu.setScreen(barScreen);
+    menu.process(ENTER);
+    display.writes = 0;
+    display.uploads = 0;
+    menu.process(UP);
+    assertEqual(1, display.writes);
+    assertEqual(1, display.uploads);
+    assertEqual(barGlyph(1), display.slots[2]);
+    for (uint8_t i = 0; i < 9; i++) {
+        menu.process(UP);
+    }
+    // Only the boundary cell is written on each step, the partial glyphs stay resident
+    assertEqual(10, display.writes);
+    assertEqual(4, display.uploads);
+}
+
+unittest(bar_refresh_writes_only_boundary_cell) {
+    CharacterDisplayRenderer renderer(&display, LCD_COLS, LCD_ROWS);
+    LcdMenu menu(renderer);
+    ItemWidget<int>* bar = static_cast<ItemWidget<int>*>(barItems[0]);
+    renderer.begin();
+    bar->setValues(20);
+    menu.setScreen(barScreen);
+    display.writes = 0;
+    bar->setValues(21);
+    menu.refresh();
+    assertEqual(1, display.writes);
+    // Nothing changed, nothing is written
+    menu.refresh();
+    assertEqual(1, display.writes);
+}
+
+unittest(bar_with_empty_range_is_full) {
+    WidgetBar<int> intBar(5, 1, 5, 5, 4);
+    assertEqual(20, intBar.getFill());
+    WidgetBar<float> floatBar(0.5f, 0.1f, 0.5f, 0.5f, 4);
+    assertEqual(20, floatBar.getFill());
+}
+
+unittest(trend_uploads_only_changed_cells) {
+    CharacterDisplayRenderer renderer(&display, LCD_COLS, LCD_ROWS);
+    LcdMenu menu(renderer);
+    ItemTrend<10>* trend = static_cast<ItemTrend<10>*>(trendItems[0]);
+    renderer.begin();
+    menu.setScreen(trendScreen);
+    for (uint8_t i = 0; i < 10; i++) {
+        trend->addSample(4);
+    }
+    display.uploads = 0;
+    menu.poll();
+    assertEqual(2, display.uploads);
+    // Same sample again, the chart looks the same
+    trend->addSample(4);
+    display.uploads = 0;
+    display.writes = 0;
+    menu.poll();
+    assertEqual(0, display.uploads);
+    assertEqual(0, display.writes);
+    // Only the cell with the newest sample changes
+    trend->addSample(8);
+    menu.poll();
+    assertEqual(1, display.uploads);
+    assertEqual(8, trend->getLevel(9));
+    assertEqual(4, trend->getLevel(0));
+}
+
+unittest_main()
@@ -0,0 +1,139 @@
+#include "fixtures.h"
+#include <ArduinoUnitTests.h>
+#include <ItemInput.h>
+#include <ItemWidget.h>
+#include <LcdMenu.h>
+#include <MenuScreen.h>
+#include <display/HeadlessDisplay.h>
+#include <renderer/CharacterDisplayRenderer.h>
+#include <widget/WidgetBar.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+// clang-format off
+MENU_SCREEN(mainScreen, mainItems,
+    ITEM_BASIC("Start service"),
+    ITEM_INPUT("Name", [](char* value) {}),
+    ITEM_WIDGET("Level", [](int level) {}, WIDGET_BAR(10, 1, 0, 40, 8)),
+    ITEM_BASIC("Settings"));
+// clang-format on
+
+HeadlessDisplay display(LCD_COLS, LCD_ROWS);
+CharacterDisplayRenderer renderer(&display, LCD_COLS, LCD_ROWS);
+LcdMenu menu(renderer);
+
+void start() {
+    startMenu(renderer, menu, mainScreen);
+}
+
+unittest(initial_frame) {
+    start();
+    assertTrue(display.matches(
+        "~Start service  \n"
+        " Name:         \\1\n"
+        "cursor 16,1\n"
+        "glyph 1 04 04 04 04 04 1F 0E 04\n",
+        &Serial));
+}
+
+unittest(partial_redraw_moves_cursor_icon) {
+    start();
+    menu.process(DOWN);
+    assertTrue(display.matches(
+        " Start service  \n"
+        "~Name:         \\1\n"
+        "cursor 6,1\n"
+        "glyph 1 04 04 04 04 04 1F 0E 04\n",
+        &Serial));
+}
+
+unittest(edit_mode_shows_blinker) {
+    start();
+    menu.process(DOWN);
+    menu.process(ENTER);
+    menu.process(RIGHT);
+    assertTrue(display.matches(
+        " Start service  \n"
+        "\\x7FName:         \\1\n"
+        "cursor 6,1 blink\n"
+        "glyph 1 04 04 04 04 04 1F 0E 04\n",
+        &Serial));
+    menu.process(BACK);
+    assertFalse(display.getFrame().blinker);
+}
+
+unittest(bar_uses_custom_glyphs) {
+    start();
+    menu.process(DOWN);
+    menu.process(DOWN);
+    menu.process(ENTER);
+    menu.process(UP);
+    assertTrue(display.matches(
+        " Name:         \\0\n"
+        "\\x7FLevel:\\xFF\\xFF\\2     \\1\n"
+        "cursor 14,1 blink\n"
+        "glyph 0 04 0E 1F 04 04 04 04 04\n"
+        "glyph 1 04 04 04 04 04 1F 0E 04\n"
+        "glyph 2 10 10 10 10 10 10 10 10\n",
+        &Serial));
+    menu.process(BACK);
+}
+
+unittest(hidden_menu_is_cleared) {
+    start();
+    menu.hide();
+    assertTrue(display.matches(
+        "                \n"
+        "                \n"
+        "cursor 0,0\n",
+        &Serial));
+    menu.show();
+    assertTrue(display.matches(
+        "~Start service  \n"
+        " Name:         \\1\n"
+        "cursor 16,1\n"
+        "glyph 1 04 04 04 04 04 1F 0E 04\n",
+        &Serial));
+}
+
+unittest(display_state_flags) {
+    HeadlessDisplay lcd(2, 1);
+    lcd.begin();
+    lcd.hide();
+    lcd.setBacklight(false);
+    lcd.drawBlinker();
+    assertTrue(lcd.matches(
+        "  \n"
+        "cursor 0,0 blink hidden dark\n"));
+    lcd.begin();
+    assertTrue(lcd.matches(
+        "  \n"
+        "cursor 0,0\n"));
+}
+
+unittest(mismatch_prints_both_frames) {
+    start();
+    Serial.out.clear();
+    assertFalse(display.matches("~Start service  \n", &Serial));
+    assertNotEqual(std::string::npos, Serial.out.find("Actual:\n~Start service  \n"));
+    assertFalse(display.matches(""));
+}
+
+unittest(glyph_writes_after_create_char_stay_out_of_cells) {
+    HeadlessDisplay lcd(4, 1);
+    lcd.begin();
+    uint8_t bitmap[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    lcd.createChar(3, bitmap);
+    lcd.draw('A');
+    assertEqual('A' & 0x1F, lcd.getGlyph(4)[0]);
+    lcd.setCursor(0, 0);
+    lcd.draw('B');
+    lcd.draw(3);
+    assertTrue(lcd.matches(
+        "B\\3  \n"
+        "cursor 2,0\n"
+        "glyph 3 01 02 03 04 05 06 07 08\n"));
+}
+
+unittest_main()
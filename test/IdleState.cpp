@@ -0,0 +1,102 @@
+#include "fixtures.h"
+#include <ArduinoUnitTests.h>
+#include <LcdMenu.h>
+#include <MenuScreen.h>
+#include <input/KeyboardAdapter.h>
+#include <renderer/CharacterDisplayRenderer.h>
+#include <utils/StdMutexLock.h>
+#include <utils/UpdateQueue.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+BaseItemValue* statusItem = ITEM_VALUE("Status");
+
+// clang-format off
+MENU_SCREEN(mainScreen, mainItems,
+    statusItem,
+    ITEM_BASIC("Settings"),
+    ITEM_BASIC("Blink SOS"));
+// clang-format on
+
+NullDisplay display;
+CharacterDisplayRenderer renderer(&display, LCD_COLS, LCD_ROWS);
+LcdMenu menu(renderer);
+KeyStream keys;
+KeyboardAdapter keyboard(&menu, &keys);
+
+/**
+ * @brief Sleep on the virtual clock until the menu has to be polled again.
+ */
+unsigned long sleep() {
+    MenuIdleState state;
+    menu.getIdleState(state);
+    unsigned long time = state.getSleepTime(millis());
+    GODMODE()->micros += time * 1000;
+    return time;
+}
+
+unittest(sleeps_until_display_timeout) {
+    renderer.begin();
+    renderer.setTimeout(2500);
+    menu.setScreen(mainScreen);
+    menu.poll();
+    MenuIdleState state;
+    assertTrue(menu.getIdleState(state));
+    assertTrue(state.timers);
+    assertFalse(state.renders);
+    assertFalse(state.input);
+    // Woken up at most every POLL_MAX_SLEEP, then right at the timeout
+    assertEqual(POLL_MAX_SLEEP, sleep());
+    menu.poll();
+    assertEqual(POLL_MAX_SLEEP, sleep());
+    menu.poll();
+    assertEqual(500, sleep());
+    assertTrue(display.visible);
+    menu.poll();
+    assertFalse(display.visible);
+    renderer.setTimeout(0);
+}
+
+unittest(input_prevents_sleep) {
+    renderer.begin();
+    menu.setScreen(mainScreen);
+    keys.keys = "\r";
+    MenuIdleState state;
+    assertFalse(menu.getIdleState(state));
+    assertTrue(state.input);
+    assertEqual(0, sleep());
+    keyboard.observe();
+    // A single CR becomes ENTER once no LF follows, the keyboard wakes the menu for it
+    assertTrue(menu.getIdleState(state));
+    assertEqual(THRESHOLD, sleep());
+    menu.poll();
+    assertTrue(menu.getIdleState(state));
+    assertFalse(state.timers);
+}
+
+unittest(queued_update_prevents_sleep) {
+    UpdateQueue<StdMutexLock, 2> updates;
+    menu.setUpdateQueue(&updates);
+    menu.setScreen(mainScreen);
+    updates.post(statusItem, "Ready");
+    MenuIdleState state;
+    assertFalse(menu.getIdleState(state));
+    assertTrue(state.renders);
+    menu.poll();
+    assertTrue(menu.getIdleState(state));
+    menu.setUpdateQueue(NULL);
+}
+
+uint8_t wakePins[] = {2, 3};
+uint8_t attached = 0;
+
+unittest(reports_wake_pins_of_adapters) {
+    keyboard.setWakePins(wakePins, 2);
+    attached = 0;
+    assertEqual(2, menu.getWakePins([](uint8_t pin) { attached |= 1 << pin; }));
+    assertEqual(0x0C, attached);
+    keyboard.setWakePins(NULL, 0);
+}
+
+unittest_main()
@@ -0,0 +1,125 @@
+#include "fixtures.h"
+#include <ArduinoUnitTests.h>
+#include <LcdMenu.h>
+#include <MenuScreen.h>
+#include <input/InputRecorder.h>
+#include <input/InputReplay.h>
+#include <input/KeyboardAdapter.h>
+#include <renderer/CharacterDisplayRenderer.h>
+#include <utils/benchmark.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+// clang-format off
+MENU_SCREEN(mainScreen, mainItems,
+    ITEM_BASIC("Start service"),
+    ITEM_BASIC("Connect to WiFi"),
+    ITEM_BASIC("Settings"),
+    ITEM_BASIC("Blink SOS"),
+    ITEM_BASIC("Blink random"));
+// clang-format on
+
+ManualClock virtualClock;
+NullDisplay display;
+CharacterDisplayRenderer renderer(&display, LCD_COLS, LCD_ROWS);
+LcdMenu menu(renderer);
+KeyStream keys;
+KeyboardAdapter keyboard(&menu, &keys);
+
+void start() {
+    setMenuClock(&virtualClock);
+    startMenu(renderer, menu, mainScreen);
+}
+
+unittest(records_use_delta_timestamps) {
+    uint8_t storage[16];
+    RecordBuffer buffer(storage, sizeof(storage));
+    assertEqual(2, writeInputRecord(buffer, 5, DOWN));
+    assertEqual(3, writeInputRecord(buffer, 300, UP));
+    InputRecordReader reader;
+    assertTrue(reader.read(buffer));
+    assertEqual((uint32_t)5, reader.delta);
+    assertEqual(DOWN, reader.command);
+    // Records may arrive in pieces
+    assertFalse(reader.feed(storage[2]));
+    assertFalse(reader.feed(storage[3]));
+    assertTrue(reader.feed(storage[4]));
+    assertEqual((uint32_t)300, reader.delta);
+    assertEqual(UP, reader.command);
+}
+
+unittest(records_commands_reaching_the_menu) {
+    start();
+    uint8_t storage[16];
+    RecordBuffer recording(storage, sizeof(storage));
+    InputRecorder recorder(&menu, &keyboard, &recording);
+    keys.keys = "\x1B[B";
+    for (uint8_t i = 0; i < 3; i++) {
+        virtualClock.advance(10);
+        recorder.observe();
+    }
+    virtualClock.advance(200);
+    menu.process(DOWN);
+    assertEqual(2, recorder.getCount());
+    assertEqual(2, menu.getCursor());
+    const uint8_t expected[] = {30, DOWN, 0xC8, 0x01, DOWN};
+    assertEqual(sizeof(expected), recording.getLength());
+    assertEqual(0, memcmp(expected, recording.getData(), sizeof(expected)));
+}
+
+unittest(stops_recording_when_full) {
+    start();
+    uint8_t storage[3];
+    RecordBuffer recording(storage, sizeof(storage));
+    InputRecorder recorder(&menu, NULL, &recording);
+    menu.process(DOWN);
+    menu.process(DOWN);
+    assertTrue(recorder.isFull());
+    assertEqual(1, recorder.getCount());
+}
+
+unittest(replays_at_accelerated_pace) {
+    start();
+    uint8_t storage[] = {100, DOWN, 0xC8, 0x01, DOWN, 10, DOWN};
+    RecordBuffer recording(storage, sizeof(storage), sizeof(storage));
+    InputReplay replay(&menu, &recording, 2);
+    replay.start();
+    virtualClock.advance(49);
+    menu.poll();
+    assertEqual(0, menu.getCursor());
+    virtualClock.advance(1);
+    menu.poll();
+    assertEqual(1, menu.getCursor());
+    virtualClock.advance(99);
+    replay.observe();
+    assertEqual(1, menu.getCursor());
+    assertFalse(replay.isDone());
+    // Polled late, both commands which are due are sent
+    virtualClock.advance(20);
+    menu.poll();
+    assertEqual(3, menu.getCursor());
+    assertTrue(replay.isDone());
+}
+
+unittest(recording_is_a_benchmark_workload) {
+    start();
+    uint8_t storage[] = {100, DOWN, 5, DOWN, 7, ENTER, 120, UP};
+    RecordBuffer recording(storage, sizeof(storage), sizeof(storage));
+    WcetBenchmark<1> benchmark(menu, micros);
+    assertEqual(4, benchmark.run(0, F("Recording"), recording));
+    assertEqual(1, menu.getCursor());
+}
+
+unittest(adapters_without_menu) {
+    KeyStream stream;
+    {
+        KeyboardAdapter keyboard(NULL, &stream);
+        InputRecorder recorder(NULL, &keyboard, &Serial);
+        InputReplay replay(NULL, &stream);
+        replay.stop();
+    }
+    assertEqual(0, stream.available());
+}
+
+unittest_main()
@@ -0,0 +1,28 @@
+#include <ArduinoUnitTests.h>
+#include <ItemTrend.h>
+
+unittest(samples_are_scaled_to_the_range) {
+    ItemTrend<4> trend("Trend", 10, 30);
+    trend.addSample(10);
+    trend.addSample(20);
+    trend.addSample(30);
+    trend.addSample(40);
+    assertEqual(0, trend.getLevel(0));
+    assertEqual(4, trend.getLevel(1));
+    assertEqual(8, trend.getLevel(2));
+    assertEqual(8, trend.getLevel(3));
+    // Oldest sample is replaced
+    trend.addSample(0);
+    assertEqual(4, trend.getLevel(0));
+    assertEqual(0, trend.getLevel(3));
+}
+
+unittest(empty_range_shows_empty_columns) {
+    ItemTrend<2> trend("Trend", 5, 5);
+    trend.addSample(5);
+    trend.addSample(100);
+    assertEqual(0, trend.getLevel(0));
+    assertEqual(0, trend.getLevel(1));
+}
+
+unittest_main()
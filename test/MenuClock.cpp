@@ -0,0 +1,121 @@
+#include "fixtures.h"
+#include <ArduinoUnitTests.h>
+#include <ItemValue.h>
+#include <LcdMenu.h>
+#include <MenuScreen.h>
+#include <input/KeyboardAdapter.h>
+#include <renderer/CharacterDisplayRenderer.h>
+#include <utils/MenuClock.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+// 256 ms before the 32 bit time wraps around
+#define BEFORE_WRAP 0xFFFFFF00
+
+int speed = 0;
+
+// clang-format off
+MENU_SCREEN(mainScreen, mainItems,
+    ITEM_VALUE("Speed", &speed, "%d", 100),
+    ITEM_BASIC("Settings"),
+    ITEM_BASIC("Setup"),
+    ITEM_BASIC("Start"));
+// clang-format on
+
+ManualClock virtualClock;
+NullDisplay display;
+CharacterDisplayRenderer renderer(&display, LCD_COLS, LCD_ROWS);
+LcdMenu menu(renderer);
+KeyStream keys;
+KeyboardAdapter keyboard(&menu, &keys);
+
+void start(uint32_t time) {
+    setMenuClock(&virtualClock);
+    virtualClock.set(time);
+    startMenu(renderer, menu, mainScreen);
+    menu.poll();
+}
+
+unittest(manual_clock_replaces_millis) {
+    virtualClock.set(1234);
+    setMenuClock(&virtualClock);
+    assertEqual((uint32_t)1234, menuMillis());
+    virtualClock.advance(10);
+    assertEqual((uint32_t)1244, menuMillis());
+    setMenuClock(NULL);
+    GODMODE()->micros = 5000;
+    assertEqual((uint32_t)5, menuMillis());
+}
+
+unittest(display_timeout_across_wraparound) {
+    start(BEFORE_WRAP);
+    renderer.setTimeout(1000);
+    virtualClock.advance(999);
+    menu.poll();
+    assertTrue(display.visible);
+    virtualClock.advance(1);
+    menu.poll();
+    assertFalse(display.visible);
+    renderer.setTimeout(0);
+    menu.process(UP);
+}
+
+unittest(update_timer_across_wraparound) {
+    start(BEFORE_WRAP);
+    virtualClock.advance(DISPLAY_TIMEOUT - 1);
+    renderer.updateTimer();
+    assertTrue(display.visible);
+    virtualClock.advance(1);
+    renderer.updateTimer();
+    assertFalse(display.visible);
+    menu.process(UP);
+}
+
+unittest(keyboard_idle_across_wraparound) {
+    start(BEFORE_WRAP + 200);
+    keys.keys = "\x1B";
+    menu.process(DOWN);
+    assertEqual(1, menu.getCursor());
+    keyboard.observe();
+    virtualClock.advance(THRESHOLD - 1);
+    menu.poll();
+    keyboard.observe();
+    assertEqual(1, menu.getCursor());
+    // A single ESC becomes BACK, which does nothing on the root screen but ends the sequence
+    virtualClock.advance(1);
+    MenuIdleState state;
+    menu.getIdleState(state);
+    assertTrue(state.timers);
+    menu.poll();
+    menu.getIdleState(state);
+    assertFalse(state.timers);
+}
+
+unittest(type_ahead_times_out_across_wraparound) {
+    start(BEFORE_WRAP + 100);
+    menu.process('s');
+    assertEqual(1, menu.getCursor());
+    virtualClock.advance(TYPE_AHEAD_TIMEOUT);
+    menu.process('t');
+    assertEqual(3, menu.getCursor());
+    // A new prefix, "stse" would match nothing
+    virtualClock.advance(TYPE_AHEAD_TIMEOUT + 1);
+    menu.process('s');
+    menu.process('e');
+    assertEqual(1, menu.getCursor());
+}
+
+unittest(value_is_sampled_across_wraparound) {
+    start(BEFORE_WRAP + 50);
+    speed = 42;
+    virtualClock.advance(99);
+    display.writes = 0;
+    menu.poll();
+    assertEqual(0, display.writes);
+    virtualClock.advance(1);
+    menu.poll();
+    assertTrue(display.writes > 0);
+    assertEqual("42", static_cast<BaseItemValue*>(mainItems[0])->getValue());
+}
+
+unittest_main()
@@ -0,0 +1,101 @@
+#include <ArduinoUnitTests.h>
+#include <ItemSubMenu.h>
+#include <LcdMenu.h>
+#include <MenuIndex.h>
+#include <MenuScreen.h>
+
+extern MenuScreen* settingsScreen;
+extern MenuScreen* networkScreen;
+
+// clang-format off
+MENU_SCREEN(mainScreen, mainItems,
+    ITEM_BASIC("Start service"),
+    ITEM_SUBMENU("Settings", settingsScreen),
+    ITEM_BASIC("About"));
+
+MENU_SCREEN(settingsScreen, settingsItems,
+    ITEM_SUBMENU("Network", networkScreen),
+    ITEM_BASIC("Contrast"),
+    ITEM_SUBMENU("Home", mainScreen));
+
+MENU_SCREEN(networkScreen, networkItems,
+    ITEM_BASIC("DHCP"),
+    ITEM_BASIC("Address"));
+// clang-format on
+
+unittest(hash_is_fnv1a) {
+    assertEqual(0x811C9DC5UL, menuHash(""));
+    assertEqual(0xE40C292CUL, menuHash("a"));
+    // Known at compile time
+    static_assert(MENU_ID("Settings/Network/DHCP") == menuFold(menuHash("Settings/Network/DHCP")), "");
+    // Hashes folding to 0 get another ID, 0 is no item
+    assertEqual(1, menuFold(0x12341234UL));
+    assertEqual(0x1234, menuFold(0x12340000UL));
+}
+
+unittest(build_indexes_all_items_once) {
+    MenuIndex index;
+    assertTrue(index.build(mainScreen));
+    // "Home" leads back to the root and is not followed
+    assertEqual(8, index.getCount());
+    assertEqual(0, index.getCollisions());
+    assertFalse(index.isTruncated());
+}
+
+unittest(find_by_path) {
+    MenuIndex index;
+    index.build(mainScreen);
+    assertEqual(networkItems[0], index.getItem("Settings/Network/DHCP"));
+    assertEqual(networkScreen, index.getScreen("Settings/Network/DHCP"));
+    assertEqual(mainItems[2], index.getItem("About"));
+    assertEqual(mainScreen, index.getScreen("About"));
+    assertEqual(settingsItems[2], index.getItem("Settings/Home"));
+    assertNull(index.getItem("DHCP"));
+    assertNull(index.getItem("Network/DHCP"));
+    assertNull(index.getItem("Settings/Network/DHCP/"));
+    assertNull(index.getItem("Settings/Home/About"));
+}
+
+unittest(find_by_id) {
+    MenuIndex index;
+    index.build(mainScreen);
+    assertEqual(networkItems[1], index.getItem(MENU_ID("Settings/Network/Address")));
+    assertEqual(settingsScreen, index.getScreen(MENU_ID("Settings/Contrast")));
+    assertEqual(MENU_ID("Settings/Network"), index.getId(settingsItems[0]));
+    const MenuIndex::Entry* entry = index.find(MENU_ID("Settings/Network/DHCP"));
+    assertNotNull(entry);
+    assertEqual(networkItems[0], entry->item);
+    assertEqual(networkScreen, entry->screen);
+    assertEqual(settingsItems[0], index.getParent(entry)->item);
+    assertEqual(mainItems[1], index.getParent(index.getParent(entry))->item);
+    assertNull(index.getParent(index.getParent(index.getParent(entry))));
+    assertNull(index.find(MENU_ID("Settings/Network/Gateway")));
+    MenuItem* unknown = ITEM_BASIC("Unknown");
+    assertEqual(MENU_ID_NONE, index.getId(unknown));
+    delete unknown;
+}
+
+unittest(ids_survive_reordering) {
+    MenuIndex index;
+    index.build(mainScreen);
+    uint16_t id = index.getId(networkItems[1]);
+    MenuItem* address = networkScreen->removeItem(1);
+    networkScreen->insertItem(0, address);
+    index.build(mainScreen);
+    assertEqual(id, index.getId(address));
+    assertEqual(address, index.getItem("Settings/Network/Address"));
+    networkScreen->insertItem(1, networkScreen->removeItem(0));
+}
+
+unittest(colliding_ids_are_counted) {
+    // Same text twice on one screen, both paths hash the same
+    MenuItem* twinItems[] = {ITEM_BASIC("Twin"), ITEM_BASIC("Twin"), ITEM_BASIC("Other"), nullptr};
+    MenuScreen twinScreen(twinItems);
+    MenuIndex index;
+    index.build(&twinScreen);
+    assertEqual(1, index.getCollisions());
+    assertNotNull(index.getItem("Twin"));
+    assertEqual(twinItems[2], index.getItem("Other"));
+}
+
+unittest_main()
@@ -0,0 +1,309 @@
+#include "fixtures.h"
+#include <ArduinoUnitTests.h>
+#include <ItemInput.h>
+#include <ItemValue.h>
+#include <LcdMenu.h>
+#include <MenuScreen.h>
+#include <renderer/CharacterDisplayRenderer.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+// clang-format off
+MENU_SCREEN(searchScreen, searchItems,
+    ITEM_BASIC("Start service"),
+    ITEM_BASIC("Connect to WiFi"),
+    ITEM_BASIC("Settings"),
+    ITEM_BASIC("Blink SOS"),
+    ITEM_BASIC("Setup"),
+    ITEM_BASIC("Blink random"));
+
+MENU_SCREEN(dynamicScreen, dynamicItems,
+    ITEM_BASIC("Item 1"),
+    ITEM_BASIC("Item 2"),
+    ITEM_BASIC("Item 3"));
+
+int speed = 10;
+
+MENU_SCREEN(marqueeScreen, marqueeItems,
+    ITEM_BASIC("Connect to the access point"),
+    ITEM_INPUT("Name of the access point", [](char* value) {}),
+    ITEM_BASIC("Short"));
+
+MENU_SCREEN(valueScreen, valueItems,
+    ITEM_BASIC("Header"),
+    ITEM_VALUE("Speed", &speed, "%d", 100));
+// clang-format on
+
+NullDisplay display;
+CharacterDisplayRenderer renderer(&display, LCD_COLS, LCD_ROWS);
+LcdMenu menu(renderer);
+
+unittest(type_ahead_jumps_to_prefix) {
+    menu.setScreen(searchScreen);
+    menu.reset();
+    menu.process('b');
+    assertEqual(3, menu.getCursor());
+    menu.process('l');
+    assertEqual(3, menu.getCursor());
+}
+
+unittest(type_ahead_cycles_same_letter) {
+    menu.setScreen(searchScreen);
+    menu.reset();
+    menu.process('s');
+    assertEqual(2, menu.getCursor());
+    menu.process('s');
+    assertEqual(4, menu.getCursor());
+    menu.process('s');
+    assertEqual(0, menu.getCursor());
+}
+
+unittest(type_ahead_prefix_times_out) {
+    menu.setScreen(searchScreen);
+    menu.reset();
+    menu.process('s');
+    menu.process('e');
+    menu.process('t');
+    menu.process('u');
+    assertEqual(4, menu.getCursor());
+    GODMODE()->micros += (TYPE_AHEAD_TIMEOUT + 1) * 1000UL;
+    menu.process('c');
+    assertEqual(1, menu.getCursor());
+}
+
+unittest(filter_narrows_items) {
+    menu.setScreen(searchScreen);
+    menu.reset();
+    menu.setCursor(1);
+    menu.setFilter("in");
+    assertEqual(3, searchScreen->getVisibleCount());
+    assertEqual(2, menu.getCursor());
+    menu.process(DOWN);
+    assertEqual(3, menu.getCursor());
+    menu.process(DOWN);
+    assertEqual(5, menu.getCursor());
+    menu.process(DOWN);
+    assertEqual(5, menu.getCursor());
+    menu.setFilter("ink");
+    assertEqual(2, searchScreen->getVisibleCount());
+    assertEqual(5, menu.getCursor());
+    menu.setFilter(NULL);
+    assertEqual(6, searchScreen->getVisibleCount());
+    assertEqual(1, menu.getCursor());
+}
+
+unittest(filter_by_typing) {
+    menu.setScreen(searchScreen);
+    menu.reset();
+    searchScreen->setFilterable(true);
+    menu.process('s');
+    menu.process('o');
+    assertEqual("so", searchScreen->getFilter());
+    assertEqual(1, searchScreen->getVisibleCount());
+    assertEqual(3, menu.getCursor());
+    menu.process(BACKSPACE);
+    assertEqual(4, searchScreen->getVisibleCount());
+    assertEqual(3, menu.getCursor());
+    menu.process('x');
+    assertEqual(0, searchScreen->getVisibleCount());
+    menu.process(BACK);
+    assertEqual("", searchScreen->getFilter());
+    assertEqual(0, menu.getCursor());
+    searchScreen->setFilterable(false);
+}
+
+unittest(filter_matching_nothing_keeps_focus) {
+    menu.setScreen(searchScreen);
+    menu.reset();
+    menu.setCursor(3);
+    menu.setFilter("zz");
+    assertEqual(0, searchScreen->getVisibleCount());
+    assertEqual(3, menu.getCursor());
+    menu.setFilter("blink");
+    assertEqual(3, menu.getCursor());
+    menu.setFilter(NULL);
+    assertEqual(3, menu.getCursor());
+    // Screen without items
+    MenuItem* noItems[] = {nullptr};
+    MenuScreen emptyScreen(noItems);
+    menu.setScreen(&emptyScreen);
+    menu.setFilter("a");
+    assertEqual(0, menu.getCursor());
+    menu.setFilter(NULL);
+    menu.setScreen(searchScreen);
+}
+
+unittest(hiding_all_items_keeps_focus) {
+    menu.setScreen(dynamicScreen);
+    menu.reset();
+    menu.setCursor(1);
+    for (uint8_t i = 0; i < 3; i++) {
+        dynamicScreen->setItemHidden(i, true);
+    }
+    // Focus moved on to the last item before it was hidden as well
+    assertEqual(0, dynamicScreen->getVisibleCount());
+    assertEqual(2, menu.getCursor());
+    dynamicScreen->setItemHidden(2, false);
+    assertEqual(2, menu.getCursor());
+    dynamicScreen->setItemHidden(0, false);
+    dynamicScreen->setItemHidden(1, false);
+    assertEqual(2, menu.getCursor());
+}
+
+unittest(hidden_items_are_skipped) {
+    menu.setScreen(searchScreen);
+    menu.reset();
+    searchScreen->setItemHidden(1, true);
+    searchScreen->setItemHidden(2, true);
+    assertEqual(4, searchScreen->getVisibleCount());
+    menu.process(DOWN);
+    assertEqual(3, menu.getCursor());
+    menu.process(UP);
+    assertEqual(0, menu.getCursor());
+    searchScreen->setItemHidden(0, true);
+    assertEqual(3, menu.getCursor());
+    searchScreen->setItemHidden(0, false);
+    searchScreen->setItemHidden(1, false);
+    searchScreen->setItemHidden(2, false);
+    assertEqual(6, searchScreen->getVisibleCount());
+    assertEqual(3, menu.getCursor());
+}
+
+unittest(disabled_items_are_skipped) {
+    menu.setScreen(searchScreen);
+    menu.reset();
+    searchScreen->setItemEnabled(1, false);
+    searchScreen->setItemEnabled(2, false);
+    menu.process(DOWN);
+    assertEqual(3, menu.getCursor());
+    menu.process(UP);
+    assertEqual(0, menu.getCursor());
+    searchScreen->setItemEnabled(5, false);
+    menu.setCursor(5);
+    assertEqual(4, menu.getCursor());
+    searchScreen->setItemEnabled(0, false);
+    menu.reset();
+    assertEqual(3, menu.getCursor());
+    for (uint8_t i = 0; i < 6; i++) {
+        searchScreen->setItemEnabled(i, true);
+    }
+    menu.reset();
+    assertEqual(0, menu.getCursor());
+}
+
+unittest(insert_keeps_focused_item) {
+    menu.setScreen(dynamicScreen);
+    menu.reset();
+    menu.process(DOWN);
+    assertEqual(1, menu.getCursor());
+    assertTrue(menu.insertItem(0, ITEM_BASIC("Item 0")));
+    assertEqual(4, dynamicScreen->getItemCount());
+    assertEqual(2, menu.getCursor());
+    assertTrue(menu.insertItem(4, ITEM_BASIC("Item 4")));
+    assertEqual(2, menu.getCursor());
+    assertFalse(menu.insertItem(7, ITEM_BASIC("Item 7")));
+    assertEqual(5, dynamicScreen->getItemCount());
+    menu.process(DOWN);
+    menu.process(DOWN);
+    assertEqual(4, menu.getCursor());
+    assertEqual("Item 4", dynamicScreen->getItemAt(4)->getText());
+}
+
+unittest(remove_moves_focus_to_next_item) {
+    menu.setScreen(dynamicScreen);
+    menu.setCursor(2);
+    assertEqual("Item 2", menu.removeItem(2)->getText());
+    assertEqual(4, dynamicScreen->getItemCount());
+    assertEqual(2, menu.getCursor());
+    assertEqual("Item 3", dynamicScreen->getItemAt(2)->getText());
+    menu.setCursor(3);
+    menu.removeItem(3);
+    assertEqual(2, menu.getCursor());
+    assertNull(menu.removeItem(3));
+}
+
+unittest(replace_keeps_flags) {
+    menu.setScreen(dynamicScreen);
+    menu.reset();
+    dynamicScreen->setItemEnabled(1, false);
+    assertEqual("Item 1", menu.replaceItem(1, ITEM_BASIC("Replaced"))->getText());
+    assertEqual("Replaced", dynamicScreen->getItemAt(1)->getText());
+    assertFalse(dynamicScreen->isItemEnabled(1));
+    while (dynamicScreen->getItemCount() > 0) {
+        menu.removeItem(0);
+    }
+    assertEqual(0, menu.getCursor());
+    menu.process(DOWN);
+    assertEqual(0, menu.getCursor());
+}
+
+unittest(changes_leave_the_constructor_array_alone) {
+    MenuItem* first = ITEM_BASIC("First");
+    MenuItem* second = ITEM_BASIC("Second");
+    MenuItem* third = ITEM_BASIC("Third");
+    MenuItem* staticItems[] = {first, second, third, nullptr};
+    MenuScreen screen(staticItems);
+    assertEqual(first, screen.removeItem(0));
+    assertEqual(third, screen.replaceItem(1, first));
+    assertEqual(2, screen.getItemCount());
+    assertEqual(second, screen.getItemAt(0));
+    assertEqual(first, screen.getItemAt(1));
+    // The caller's array still holds the items it was built with
+    assertEqual(first, staticItems[0]);
+    assertEqual(second, staticItems[1]);
+    assertEqual(third, staticItems[2]);
+    assertNull(staticItems[3]);
+}
+
+unittest(poll_redraws_changed_values) {
+    menu.setScreen(valueScreen);
+    menu.reset();
+    assertEqual("10", static_cast<ItemValue<int>*>(valueItems[1])->getValue());
+    display.writes = 0;
+    speed = 20;
+    menu.poll();
+    assertEqual(0, display.writes);
+    GODMODE()->micros += 100000;
+    menu.poll();
+    assertEqual("20", static_cast<ItemValue<int>*>(valueItems[1])->getValue());
+    // Only the digit which changed is written
+    assertEqual(1, display.writes);
+    display.writes = 0;
+    GODMODE()->micros += 100000;
+    menu.poll();
+    assertEqual(0, display.writes);
+}
+
+unittest(marquee_scrolls_only_focused_row) {
+    renderer.setMarquee(200, 1000);
+    menu.setScreen(marqueeScreen);
+    menu.reset();
+    display.writes = 0;
+    GODMODE()->micros += 999000;
+    menu.poll();
+    assertEqual(0, display.writes);
+    GODMODE()->micros += 1000;
+    menu.poll();
+    // The whole text shifts by one column, but only on the focused row
+    assertTrue(display.writes > 0);
+    assertTrue(display.writes < LCD_COLS);
+    assertEqual(0, renderer.viewShift);
+    renderer.setMarquee(0);
+}
+
+unittest(marquee_stops_in_edit_mode) {
+    renderer.setMarquee(200, 0);
+    menu.setScreen(marqueeScreen);
+    menu.reset();
+    menu.process(DOWN);
+    menu.process(ENTER);
+    display.writes = 0;
+    GODMODE()->micros += 5000000;
+    menu.poll();
+    assertEqual(0, display.writes);
+    menu.process(BACK);
+    renderer.setMarquee(0);
+}
+
+unittest_main()
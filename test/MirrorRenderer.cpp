@@ -0,0 +1,185 @@
+#include "fixtures.h"
+#include <ArduinoUnitTests.h>
+#include <ItemInput.h>
+#include <ItemWidget.h>
+#include <LcdMenu.h>
+#include <MenuScreen.h>
+#include <renderer/CharacterDisplayRenderer.h>
+#include <renderer/MirrorRenderer.h>
+#include <widget/WidgetBar.h>
+
+char name[8] = "Bob";
+
+// clang-format off
+MENU_SCREEN(mainScreen, mainItems,
+    ITEM_BASIC("Start service"),
+    ITEM_INPUT("Name", name, [](char* value) {}),
+    ITEM_WIDGET("Level", [](int level) {}, WIDGET_BAR(10, 1, 0, 40, 8)),
+    ITEM_BASIC("Settings"));
+// clang-format on
+
+ManualClock virtualClock;
+CountingDisplay panel(16, 2);
+CountingDisplay service(20, 4);
+CharacterDisplayRenderer panelRenderer(&panel, 16, 2);
+CharacterDisplayRenderer serviceRenderer(&service, 20, 4);
+MirrorRenderer renderer(4);
+LcdMenu menu(renderer);
+
+void start() {
+    static bool added = false;
+    if (!added) {
+        renderer.addTarget(&panelRenderer);
+        renderer.addTarget(&serviceRenderer);
+        added = true;
+    }
+    setMenuClock(&virtualClock);
+    startMenu(renderer, menu, mainScreen);
+}
+
+unittest(uses_smallest_geometry) {
+    start();
+    assertEqual(2, renderer.getMaxRows());
+    assertTrue(panel.matches(
+        "~Start service  \n"
+        " Name:Bob      \\1\n"
+        "cursor 16,1\n"
+        "glyph 1 04 04 04 04 04 1F 0E 04\n",
+        &Serial));
+    assertTrue(service.matches(
+        "~Start service      \n"
+        " Name:Bob          \\1\n"
+        "                    \n"
+        "                    \n"
+        "cursor 20,1\n"
+        "glyph 1 04 04 04 04 04 1F 0E 04\n",
+        &Serial));
+}
+
+unittest(each_target_writes_its_changed_cells) {
+    start();
+    panel.writes = 0;
+    service.writes = 0;
+    menu.process(DOWN);
+    assertEqual(2, panel.writes);
+    assertEqual(2, service.writes);
+    assertEqual('~', panel.getFrame().at(0, 1));
+    assertEqual('~', service.getFrame().at(0, 1));
+}
+
+unittest(unchanged_frame_is_skipped) {
+    start();
+    menu.process(DOWN);
+    panel.writes = panel.moves = 0;
+    service.writes = service.moves = 0;
+    menu.process(LEFT);
+    menu.poll();
+    assertEqual(0, panel.writes + panel.moves);
+    assertEqual(0, service.writes + service.moves);
+}
+
+unittest(budget_delays_slow_target) {
+    setMenuClock(&virtualClock);
+    // Second target may be flushed every 200 ms, the first one with every frame
+    MirrorRenderer slow(4);
+    CountingDisplay fastPanel(16, 2);
+    CountingDisplay slowPanel(16, 2);
+    CharacterDisplayRenderer fastRenderer(&fastPanel, 16, 2);
+    CharacterDisplayRenderer slowRenderer(&slowPanel, 16, 2);
+    slow.addTarget(&fastRenderer);
+    slow.addTarget(&slowRenderer, 200);
+    LcdMenu slowMenu(slow);
+    slow.begin();
+    slowMenu.setScreen(mainScreen);
+    slowMenu.reset();
+    virtualClock.advance(300);
+    slowMenu.process(DOWN);
+    assertEqual('~', fastPanel.getFrame().at(0, 1));
+    assertEqual('~', slowPanel.getFrame().at(0, 1));
+    virtualClock.advance(50);
+    slowMenu.process(UP);
+    slowMenu.process(DOWN);
+    slowMenu.process(DOWN);
+    assertEqual('~', fastPanel.getFrame().at(0, 1));
+    assertEqual(' ', fastPanel.getFrame().at(0, 0));
+    // Slow target still shows the frame before
+    assertEqual(" Start service  ", std::string((char*)slowPanel.getFrame().cells, 16));
+    slowPanel.writes = 0;
+    virtualClock.advance(150);
+    slowMenu.poll();
+    assertEqual(" Name:Bob      ", std::string((char*)slowPanel.getFrame().cells, 15));
+    assertEqual('~', slowPanel.getFrame().at(0, 1));
+    // Only the latest frame is drawn, not the ones in between
+    assertLess(slowPanel.writes, 30);
+}
+
+unittest(budget_delays_bytes_on_slow_target) {
+    setMenuClock(&virtualClock);
+    MirrorRenderer slow(4);
+    CountingDisplay fastPanel(16, 2);
+    CountingDisplay slowPanel(16, 2);
+    CharacterDisplayRenderer fastRenderer(&fastPanel, 16, 2);
+    CharacterDisplayRenderer slowRenderer(&slowPanel, 16, 2);
+    slow.addTarget(&fastRenderer);
+    slow.addTarget(&slowRenderer, 200);
+    LcdMenu slowMenu(slow);
+    slow.begin();
+    slowMenu.setScreen(mainScreen);
+    slowMenu.reset();
+    // Edit mode, the cursor is shown on both targets
+    virtualClock.advance(300);
+    slowMenu.process(DOWN);
+    virtualClock.advance(300);
+    slowMenu.process(ENTER);
+    virtualClock.advance(50);
+    slowPanel.writes = 0;
+    slow.moveCursor(3, 1);
+    slow.draw('X');
+    slow.draw('Y');
+    slow.moveCursor(3, 1);
+    slow.draw('Z');
+    assertEqual('Z', fastPanel.getFrame().at(4, 1));
+    assertEqual('Y', fastPanel.getFrame().at(5, 1));
+    // Slow target waits for its budget
+    assertEqual(0, slowPanel.writes);
+    virtualClock.advance(150);
+    slowMenu.poll();
+    // Only the latest byte of each cell is drawn, 'X' is skipped
+    assertEqual('Z', slowPanel.getFrame().at(4, 1));
+    assertEqual('Y', slowPanel.getFrame().at(5, 1));
+    assertEqual(2, slowPanel.writes);
+    assertTrue(slowPanel.getFrame().blinker);
+}
+
+unittest(edit_cursor_follows_each_layout) {
+    start();
+    menu.process(DOWN);
+    menu.process(ENTER);
+    assertTrue(panel.getFrame().blinker);
+    assertTrue(service.getFrame().blinker);
+    assertEqual(9, panel.getFrame().cursorCol);
+    assertEqual(9, service.getFrame().cursorCol);
+    menu.process(LEFT);
+    assertEqual(8, panel.getFrame().cursorCol);
+    assertEqual(8, service.getFrame().cursorCol);
+    menu.process(BACK);
+    assertFalse(panel.getFrame().blinker);
+    assertFalse(service.getFrame().blinker);
+}
+
+unittest(glyphs_are_requested_from_each_target) {
+    start();
+    menu.process(DOWN);
+    menu.process(DOWN);
+    menu.process(ENTER);
+    menu.process(UP);
+    assertEqual(std::string("\x7FLevel:\xFF\xFF\x02     \x01", 16),
+                std::string((char*)panel.getFrame().cells + 16, 16));
+    assertEqual(std::string("\x7FLevel:\xFF\xFF\x02         \x01", 20),
+                std::string((char*)service.getFrame().cells + 20, 20));
+    assertEqual(0x10, panel.getGlyph(2)[0]);
+    assertEqual(0x10, service.getGlyph(2)[0]);
+    menu.process(BACK);
+}
+
+unittest_main()
@@ -0,0 +1,218 @@
+#include <ArduinoUnitTests.h>
+#include <ItemInput.h>
+#include <LcdMenu.h>
+#include <MenuScreen.h>
+#include <display/HeadlessDisplay.h>
+#include <input/RemoteAdapter.h>
+#include <renderer/CharacterDisplayRenderer.h>
+#include <renderer/MirrorRenderer.h>
+#include <renderer/RemoteRenderer.h>
+#include <string>
+#include <vector>
+
+/**
+ * One end of an in-memory link, it reads what the other end wrote.
+ */
+class Link : public Stream {
+  public:
+    std::string* in;
+    std::string* out;
+    Link(std::string* in, std::string* out) : in(in), out(out) {}
+    size_t write(uint8_t byte) override {
+        *out += (char)byte;
+        return 1;
+    }
+    int available() override { return in->size(); }
+    int read() override {
+        if (in->empty()) return -1;
+        int c = (uint8_t)(*in)[0];
+        in->erase(0, 1);
+        return c;
+    }
+    int peek() override { return in->empty() ? -1 : (uint8_t)(*in)[0]; }
+};
+
+struct Frame {
+    uint8_t type;
+    std::string payload;
+};
+
+std::string toUnit;
+std::string toHost;
+Link unitLink(&toUnit, &toHost);
+Link hostLink(&toHost, &toUnit);
+
+void send(uint8_t type, const std::string& payload = "") {
+    RemoteFrameWriter frame(hostLink, type, payload.size());
+    frame.write(payload.c_str(), payload.size());
+    frame.end();
+}
+
+std::vector<Frame> receive() {
+    static RemoteFrameReader reader;
+    std::vector<Frame> frames;
+    while (reader.read(hostLink)) {
+        frames.push_back({reader.type, std::string((char*)reader.payload, reader.length)});
+    }
+    return frames;
+}
+
+std::string row(uint8_t index, uint8_t flags, const std::string& text, const std::string& value = "") {
+    return std::string({(char)index, (char)flags, 0, (char)text.size()}) + text + value;
+}
+
+char name[8] = "Bob";
+char pumpLabel[8] = "Pump on";
+
+// clang-format off
+MENU_SCREEN(mainScreen, mainItems,
+    ITEM_BASIC("Start service"),
+    ITEM_INPUT("Name", name, [](char* value) {}),
+    ITEM_BASIC("Settings"));
+MENU_SCREEN(pumpScreen, pumpItems,
+    ITEM_BASIC(pumpLabel));
+// clang-format on
+
+RemoteRenderer renderer(&unitLink, 16, 2);
+LcdMenu menu(renderer);
+RemoteAdapter remote(&menu, &unitLink, &renderer);
+
+void start() {
+    renderer.begin();
+    renderer.setSubscribed(false);
+    menu.setScreen(mainScreen);
+    menu.reset();
+    toUnit.clear();
+    toHost.clear();
+}
+
+unittest(crc_is_ccitt_false) {
+    uint16_t crc = 0xFFFF;
+    for (const char* c = "123456789"; *c != '\0'; c++) {
+        crc = remoteCrc(crc, *c);
+    }
+    assertEqual(0x29B1, crc);
+}
+
+unittest(reader_drops_corrupt_frames) {
+    std::string link;
+    Link out(&link, &link);
+    RemoteFrameWriter first(out, REMOTE_INPUT, 1);
+    first.write(DOWN);
+    first.end();
+    link[3] = (char)UP;  // Payload changed, CRC doesn't match
+    RemoteFrameWriter second(out, REMOTE_INPUT, 1);
+    second.write(ENTER);
+    second.end();
+    RemoteFrameReader reader;
+    assertTrue(reader.read(out));
+    assertEqual(REMOTE_INPUT, reader.type);
+    assertEqual(1, reader.length);
+    assertEqual(ENTER, reader.payload[0]);
+    assertEqual(1, reader.getErrors());
+    assertFalse(reader.read(out));
+}
+
+unittest(read_sends_whole_screen) {
+    start();
+    send(REMOTE_READ);
+    remote.observe();
+    std::vector<Frame> frames = receive();
+    assertEqual(4, frames.size());
+    assertEqual(REMOTE_SCREEN, frames[0].type);
+    assertEqual(std::string("\x10\x02", 2), frames[0].payload);
+    assertEqual(REMOTE_ROW, frames[1].type);
+    assertEqual(row(0, REMOTE_ROW_FOCUS, "Start service"), frames[1].payload);
+    assertEqual(row(1, REMOTE_ROW_BELOW | REMOTE_ROW_VALUE, "Name", "Bob"), frames[2].payload);
+    assertEqual(REMOTE_CURSOR, frames[3].type);
+    assertEqual(std::string("\x0D\x00\x00", 3), frames[3].payload);
+}
+
+unittest(input_is_processed_and_acknowledged) {
+    start();
+    send(REMOTE_INPUT, std::string({(char)DOWN, (char)DOWN, (char)DOWN}));
+    remote.observe();
+    assertEqual(2, menu.getCursor());
+    // Nothing but the answer without subscription
+    std::vector<Frame> frames = receive();
+    assertEqual(1, frames.size());
+    assertEqual(REMOTE_ACK, frames[0].type);
+    assertEqual(std::string("\x01\x03", 2), frames[0].payload);
+}
+
+unittest(subscription_sends_changed_rows) {
+    start();
+    send(REMOTE_SUBSCRIBE, "\x01");
+    remote.observe();
+    std::vector<Frame> frames = receive();
+    assertEqual(5, frames.size());
+    assertEqual(REMOTE_SCREEN, frames[0].type);
+    assertEqual(REMOTE_ACK, frames[4].type);
+    send(REMOTE_INPUT, std::string(1, (char)DOWN));
+    remote.observe();
+    frames = receive();
+    // Focus moved from the first row to the second one
+    assertEqual(4, frames.size());
+    assertEqual(row(0, 0, "Start service"), frames[0].payload);
+    assertEqual(row(1, REMOTE_ROW_FOCUS | REMOTE_ROW_BELOW | REMOTE_ROW_VALUE, "Name", "Bob"), frames[1].payload);
+    assertEqual(std::string("\x08\x01\x00", 3), frames[2].payload);
+    assertEqual(REMOTE_ACK, frames[3].type);
+    // Edit mode changes the flags and shows the blinker
+    send(REMOTE_INPUT, std::string(1, (char)ENTER));
+    remote.observe();
+    frames = receive();
+    assertEqual(3, frames.size());
+    assertEqual(row(1, REMOTE_ROW_FOCUS | REMOTE_ROW_BELOW | REMOTE_ROW_VALUE | REMOTE_ROW_EDIT, "Name", "Bob"),
+                frames[0].payload);
+    assertEqual(REMOTE_CURSOR, frames[1].type);
+    assertEqual(REMOTE_CURSOR_BLINK | REMOTE_CURSOR_EDIT, frames[1].payload[2]);
+    send(REMOTE_INPUT, std::string({(char)BACK}));
+    send(REMOTE_SUBSCRIBE, std::string(1, '\0'));
+    remote.observe();
+    receive();
+    // Unsubscribed, the changes aren't sent
+    menu.process(UP);
+    assertEqual(0, receive().size());
+}
+
+unittest(text_rewritten_in_place_is_sent) {
+    start();
+    send(REMOTE_SUBSCRIBE, "\x01");
+    remote.observe();
+    menu.setScreen(pumpScreen);
+    receive();
+    strcpy(pumpLabel, "Pump no");
+    menu.refresh();
+    std::vector<Frame> frames = receive();
+    assertEqual(1, frames.size());
+    assertEqual(row(0, REMOTE_ROW_FOCUS, "Pump no"), frames[0].payload);
+    strcpy(pumpLabel, "Pump on");
+    send(REMOTE_SUBSCRIBE, std::string(1, '\0'));
+    remote.observe();
+    receive();
+}
+
+unittest(mirror_target_follows_display) {
+    HeadlessDisplay lcd(16, 2);
+    CharacterDisplayRenderer lcdRenderer(&lcd, 16, 2);
+    RemoteRenderer remoteRenderer(&unitLink, 16, 2);
+    MirrorRenderer mirror(2);
+    mirror.addTarget(&lcdRenderer);
+    mirror.addTarget(&remoteRenderer);
+    LcdMenu mirrored(mirror);
+    RemoteAdapter mirroredRemote(&mirrored, &unitLink, &remoteRenderer);
+    mirror.begin();
+    mirrored.setScreen(mainScreen);
+    mirrored.reset();
+    toHost.clear();
+    send(REMOTE_SUBSCRIBE, "\x01");
+    send(REMOTE_INPUT, std::string(1, (char)DOWN));
+    mirroredRemote.observe();
+    std::vector<Frame> frames = receive();
+    assertEqual('~', lcd.getFrame().at(0, 1));
+    assertEqual(row(1, REMOTE_ROW_FOCUS | REMOTE_ROW_BELOW | REMOTE_ROW_VALUE, "Name", "Bob"),
+                frames[frames.size() - 3].payload);
+    assertEqual(0, mirroredRemote.getErrors());
+}
+
+unittest_main()
@@ -0,0 +1,177 @@
+#include "fixtures.h"
+#include <ArduinoUnitTests.h>
+#include <ItemInput.h>
+#include <ItemValue.h>
+#include <ItemWidget.h>
+#include <LcdMenu.h>
+#include <MenuScreen.h>
+#include <display/HeadlessDisplay.h>
+#include <display/PanelShadow.h>
+#include <renderer/CharacterDisplayRenderer.h>
+#include <widget/WidgetBar.h>
+
+char name[8] = "Bob";
+int temperature = 21;
+
+// clang-format off
+MENU_SCREEN(statusScreen, statusItems,
+    ITEM_VALUE("Temp", &temperature, "%d"),
+    ITEM_BASIC("Ready"));
+MENU_SCREEN(mainScreen, mainItems,
+    ITEM_BASIC("Start service"),
+    ITEM_INPUT("Name", name, [](char* value) {}),
+    ITEM_WIDGET("Level", [](int level) {}, WIDGET_BAR(10, 1, 0, 40, 8)),
+    ITEM_BASIC("Settings"));
+MENU_SCREEN(otherScreen, otherItems,
+    ITEM_BASIC("Back"));
+MENU_SCREEN(pumpScreen, pumpItems,
+    ITEM_WIDGET("Flow", [](int flow) {}, WIDGET_BAR(13, 1, 0, 40, 8)),
+    ITEM_BASIC("Stop"));
+// clang-format on
+
+ManualClock virtualClock;
+
+// 20x4 with a status region on top of the menu
+CountingDisplay display(20, 4);
+PanelShadow panel(20, 4);
+// Status without cursor and arrows
+CharacterDisplayRenderer statusRenderer(&display, 20, 2, 0, 0, NULL, NULL);
+CharacterDisplayRenderer menuRenderer(&display, 20, 2);
+LcdMenu status(statusRenderer);
+LcdMenu menu(menuRenderer);
+
+void start() {
+    setMenuClock(&virtualClock);
+    panel.reset();
+    statusRenderer.setViewport(0, 0, 20, 2, &panel);
+    menuRenderer.setViewport(0, 2, 20, 2, &panel);
+    startMenu(statusRenderer, status, statusScreen);
+    startMenu(menuRenderer, menu, mainScreen);
+}
+
+unittest(regions_share_the_display) {
+    display.begins = 0;
+    start();
+    assertEqual(1, display.begins);
+    assertEqual(20, menuRenderer.getMaxCols());
+    assertEqual(2, menuRenderer.getMaxRows());
+    assertTrue(display.matches(
+        "Temp:21             \n"
+        "Ready               \n"
+        "~Start service      \n"
+        " Name:Bob          \\1\n"
+        "cursor 20,3\n"
+        "glyph 1 04 04 04 04 04 1F 0E 04\n",
+        &Serial));
+}
+
+unittest(navigation_only_writes_its_region) {
+    start();
+    display.writes = 0;
+    menu.process(DOWN);
+    menu.process(DOWN);
+    assertEqual("Ready               ", std::string((char*)display.getFrame().cells + 20, 20));
+    assertEqual('~', display.getFrame().at(0, 3));
+    // Scrolling writes the changed cells of the menu rows only
+    assertLess(display.writes, 30);
+}
+
+unittest(set_screen_keeps_other_region) {
+    start();
+    display.writes = 0;
+    menu.setScreen(otherScreen);
+    assertTrue(display.matches(
+        "Temp:21             \n"
+        "Ready               \n"
+        "~Back               \n"
+        "                    \n"
+        "cursor 5,2\n",
+        &Serial));
+    // Menu region is blanked and drawn again, the status isn't touched
+    assertEqual(40 + 5, display.writes);
+    display.writes = 0;
+    temperature = 22;
+    virtualClock.advance(1000);
+    status.poll();
+    assertEqual('2', display.getFrame().at(6, 0));
+    assertEqual('~', display.getFrame().at(0, 2));
+    assertEqual(1, display.writes);
+    temperature = 21;
+}
+
+unittest(hidden_menu_clears_its_region_only) {
+    start();
+    menu.hide();
+    assertTrue(display.matches(
+        "Temp:21             \n"
+        "Ready               \n"
+        "                    \n"
+        "                    \n"
+        "cursor 20,3\n",
+        &Serial));
+    menu.show();
+    assertEqual('~', display.getFrame().at(0, 2));
+}
+
+unittest(blinker_stays_in_editing_region) {
+    start();
+    menu.process(DOWN);
+    menu.process(ENTER);
+    assertTrue(display.getFrame().blinker);
+    assertEqual(9, display.getFrame().cursorCol);
+    assertEqual(3, display.getFrame().cursorRow);
+    // Status changes while the name is edited
+    temperature = 23;
+    status.refresh();
+    assertEqual('3', display.getFrame().at(6, 0));
+    assertTrue(display.getFrame().blinker);
+    assertEqual(9, display.getFrame().cursorCol);
+    assertEqual(3, display.getFrame().cursorRow);
+    // Leaving the status doesn't turn off the blinker of the menu
+    status.process(DOWN);
+    assertTrue(display.getFrame().blinker);
+    assertEqual(3, display.getFrame().cursorRow);
+    menu.process(BACK);
+    assertFalse(display.getFrame().blinker);
+    temperature = 21;
+}
+
+unittest(side_by_side_regions_share_glyph_slots) {
+    // 40x2 with two menus next to each other
+    PanelShadow widePanel(40, 2);
+    HeadlessDisplay wide(40, 2);
+    CharacterDisplayRenderer leftRenderer(&wide, 20, 2);
+    CharacterDisplayRenderer rightRenderer(&wide, 20, 2);
+    leftRenderer.setViewport(0, 0, 20, 2, &widePanel);
+    rightRenderer.setViewport(20, 0, 20, 2, &widePanel);
+    LcdMenu left(leftRenderer);
+    LcdMenu right(rightRenderer);
+    leftRenderer.begin();
+    rightRenderer.begin();
+    left.setScreen(mainScreen);
+    left.reset();
+    right.setScreen(pumpScreen);
+    right.reset();
+    left.process(DOWN);
+    left.process(DOWN);
+    left.process(ENTER);
+    left.process(UP);
+    // Partial bars of both menus are on the display at once, each one has its own slot
+    assertTrue(wide.matches(
+        " Name:Bob          \\0~Flow:\\xFF\\xFF\\2           \n"
+        "\\x7FLevel:\\xFF\\xFF\\3         \\1 Stop               \n"
+        "cursor 14,1 blink\n"
+        "glyph 0 04 0E 1F 04 04 04 04 04\n"
+        "glyph 1 04 04 04 04 04 1F 0E 04\n"
+        "glyph 2 1C 1C 1C 1C 1C 1C 1C 1C\n"
+        "glyph 3 10 10 10 10 10 10 10 10\n",
+        &Serial));
+    // Blinker of the left menu stays while the right one moves
+    right.process(DOWN);
+    assertEqual('~', wide.getFrame().at(20, 1));
+    assertTrue(wide.getFrame().blinker);
+    assertEqual(14, wide.getFrame().cursorCol);
+    left.process(BACK);
+}
+
+unittest_main()
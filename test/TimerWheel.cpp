@@ -0,0 +1,153 @@
+#include "fixtures.h"
+#include <ArduinoUnitTests.h>
+#include <LcdMenu.h>
+#include <MenuScreen.h>
+#include <renderer/CharacterDisplayRenderer.h>
+#include <utils/TimerWheel.h>
+
+#define LCD_ROWS 2
+#define LCD_COLS 16
+
+class CountingTimer : public MenuTimer {
+  public:
+    uint8_t fired = 0;
+    uint32_t firedAt = 0;
+
+  protected:
+    void fire(uint32_t now) override {
+        fired++;
+        firedAt = now;
+    }
+};
+
+// clang-format off
+MENU_SCREEN(mainScreen, mainItems,
+    ITEM_BASIC("Start service"),
+    ITEM_BASIC("Settings"),
+    ITEM_BASIC("Blink SOS"));
+// clang-format on
+
+PowerDisplay display;
+CharacterDisplayRenderer renderer(&display, LCD_COLS, LCD_ROWS);
+LcdMenu menu(renderer);
+
+unittest(fires_deadline_across_wraparound) {
+    TimerWheel wheel;
+    CountingTimer timer;
+    uint32_t start = 0xFFFFFF00;
+    wheel.poll(start);
+    wheel.schedule(&timer, start + 0x180);
+    assertEqual((uint32_t)0x80, timer.getDeadline());
+    wheel.poll(0xFFFFFFF0);
+    wheel.poll(0x10);
+    wheel.poll(0x7F);
+    assertEqual(0, timer.fired);
+    assertTrue(timer.isArmed());
+    wheel.poll(0x85);
+    assertEqual(1, timer.fired);
+    assertEqual((uint32_t)0x85, timer.firedAt);
+    assertFalse(timer.isArmed());
+    wheel.poll(0x200);
+    assertEqual(1, timer.fired);
+}
+
+unittest(keeps_timers_of_later_rounds) {
+    TimerWheel wheel;
+    CountingTimer timer;
+    wheel.poll(1000);
+    // Same slot as 1000, three rounds of the wheel later
+    uint32_t deadline = 1000 + 3 * (TIMER_WHEEL_SLOTS << TIMER_WHEEL_RESOLUTION);
+    wheel.schedule(&timer, deadline);
+    for (uint32_t now = 1000; now < deadline; now += 7) {
+        wheel.poll(now);
+    }
+    assertEqual(0, timer.fired);
+    wheel.poll(deadline);
+    assertEqual(1, timer.fired);
+}
+
+unittest(fires_all_due_timers_after_long_gap) {
+    TimerWheel wheel;
+    CountingTimer timers[4];
+    wheel.poll(0);
+    for (uint8_t i = 0; i < 4; i++) {
+        wheel.schedule(&timers[i], 100 + i * 50);
+    }
+    wheel.poll(60000);
+    for (uint8_t i = 0; i < 4; i++) {
+        assertEqual(1, timers[i].fired);
+    }
+}
+
+unittest(fires_overdue_timer_at_next_poll) {
+    TimerWheel wheel;
+    CountingTimer timer;
+    wheel.poll(1000);
+    wheel.schedule(&timer, 900);
+    wheel.poll(1001);
+    assertEqual(1, timer.fired);
+    assertEqual((uint32_t)1001, timer.firedAt);
+    // Cancelling finds it in the slot it was put into
+    wheel.schedule(&timer, 900);
+    wheel.cancel(&timer);
+    wheel.poll(1200);
+    assertEqual(1, timer.fired);
+}
+
+unittest(cancel_and_reschedule) {
+    TimerWheel wheel;
+    CountingTimer first;
+    CountingTimer second;
+    wheel.poll(0);
+    wheel.schedule(&first, 100);
+    wheel.schedule(&second, 100);
+    wheel.cancel(&first);
+    assertFalse(first.isArmed());
+    wheel.schedule(&second, 300);
+    wheel.poll(200);
+    assertEqual(0, first.fired);
+    assertEqual(0, second.fired);
+    wheel.poll(300);
+    assertEqual(1, second.fired);
+}
+
+unittest(next_deadline_across_wraparound) {
+    TimerWheel wheel;
+    CountingTimer early;
+    CountingTimer late;
+    uint32_t deadline = 0;
+    uint32_t now = 0xFFFFFF80;
+    assertFalse(wheel.getNextDeadline(deadline));
+    wheel.schedule(&late, 0x10);
+    wheel.schedule(&early, 0xFFFFFFF0);
+    assertTrue(wheel.getNextDeadline(deadline));
+    assertEqual((uint32_t)0xFFFFFFF0, deadline);
+}
+
+unittest(poll_returns_next_wake_time) {
+    renderer.begin();
+    menu.setScreen(mainScreen);
+    uint32_t now = millis();
+    assertEqual(now + POLL_MAX_SLEEP, (uint32_t)menu.poll());
+    renderer.setTimeout(500);
+    assertEqual(now + 500, (uint32_t)menu.poll());
+    renderer.setTimeout(0);
+}
+
+unittest(poll_hides_display_after_timeout) {
+    renderer.begin();
+    renderer.setTimeout(DISPLAY_TIMEOUT);
+    menu.setScreen(mainScreen);
+    GODMODE()->micros += (DISPLAY_TIMEOUT - 1) * 1000UL;
+    menu.poll();
+    assertTrue(display.visible);
+    // Milliseconds skipped between two polls don't miss the timeout
+    GODMODE()->micros += 5000;
+    menu.poll();
+    assertFalse(display.visible);
+    menu.process(DOWN);
+    assertTrue(display.visible);
+    renderer.setTimeout(0);
+}
+
+unittest_main()
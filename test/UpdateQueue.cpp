@@ -0,0 +1,46 @@
+#include <ArduinoUnitTests.h>
+#include <ItemValue.h>
+#include <MenuScreen.h>
+#include <thread>
+#include <utils/StdMutexLock.h>
+#include <utils/UpdateQueue.h>
+
+BaseItemValue* statusItems[] = {ITEM_VALUE("Status"), ITEM_VALUE("Count"), ITEM_VALUE("Error")};
+
+#define VALUE(index) (statusItems[index]->getValue())
+
+unittest(drain_applies_latest_value) {
+    UpdateQueue<StdMutexLock, 2> updates;
+    assertTrue(updates.post(statusItems[0], "Busy"));
+    assertTrue(updates.post(statusItems[0], "Ready"));
+    assertTrue(updates.post(statusItems[1], "%d", 42));
+    assertFalse(updates.post(statusItems[2], "Full"));
+    assertEqual(2, updates.drain());
+    assertEqual("Ready", VALUE(0));
+    assertEqual("42", VALUE(1));
+    assertEqual("", VALUE(2));
+    assertEqual(0, updates.drain());
+}
+
+unittest(post_from_other_threads) {
+    UpdateQueue<StdMutexLock, 4> updates;
+    std::thread producers[2];
+    for (int p = 0; p < 2; p++) {
+        producers[p] = std::thread([&updates, p]() {
+            for (int i = 0; i <= 1000; i++) {
+                updates.post(statusItems[p], "%d", i);
+            }
+        });
+    }
+    // Drain concurrently like the UI task would
+    for (int i = 0; i < 100; i++) {
+        updates.drain();
+    }
+    producers[0].join();
+    producers[1].join();
+    updates.drain();
+    assertEqual("1000", VALUE(0));
+    assertEqual("1000", VALUE(1));
+}
+
+unittest_main()
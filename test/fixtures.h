@@ -0,0 +1,103 @@
+// Test doubles shared by the host tests.
+#pragma once
+
+#include <Arduino.h>
+#include <LcdMenu.h>
+#include <MenuScreen.h>
+#include <display/CharacterDisplayInterface.h>
+#include <display/HeadlessDisplay.h>
+
+/**
+ * Display without a bus, counting the bytes drawn and keeping whether it is shown.
+ */
+class NullDisplay : public CharacterDisplayInterface {
+  public:
+    uint16_t writes = 0;
+    bool visible = true;
+    void begin() override {}
+    void clear() override {}
+    void show() override { visible = true; }
+    void hide() override { visible = false; }
+    void draw(uint8_t byte) override { writes++; }
+    void draw(const char* text) override {}
+    void setCursor(uint8_t col, uint8_t row) override {}
+    void setBacklight(bool enabled) override {}
+    void createChar(uint8_t id, uint8_t* c) override {}
+    void drawBlinker() override {}
+    void clearBlinker() override {}
+};
+
+/**
+ * Stream reading the characters of `keys`, e.g. for a `KeyboardAdapter`.
+ */
+class KeyStream : public Stream {
+  public:
+    const char* keys = "";
+    size_t write(uint8_t c) override { return 1; }
+    int available() override { return strlen(keys); }
+    int read() override { return *keys != '\0' ? *keys++ : -1; }
+    int peek() override { return *keys != '\0' ? *keys : -1; }
+};
+
+/**
+ * Display counting the commands changing its power state.
+ */
+class PowerDisplay : public CharacterDisplayInterface {
+  public:
+    uint8_t commands = 0;
+    bool visible = true;
+    uint8_t brightness = 255;
+    void begin() override {}
+    void clear() override {}
+    void show() override {
+        visible = true;
+        commands++;
+    }
+    void hide() override {
+        visible = false;
+        commands++;
+    }
+    void draw(uint8_t byte) override {}
+    void draw(const char* text) override {}
+    void setCursor(uint8_t col, uint8_t row) override {}
+    void setBacklight(bool enabled) override { setBrightness(enabled ? 255 : 0); }
+    void setBrightness(uint8_t brightness) override {
+        this->brightness = brightness;
+        commands++;
+    }
+    void createChar(uint8_t id, uint8_t* c) override {}
+    void drawBlinker() override {}
+    void clearBlinker() override {}
+};
+
+/**
+ * Headless display counting the bytes drawn, the cursor moves and the calls to `begin`.
+ */
+class CountingDisplay : public HeadlessDisplay {
+  public:
+    uint16_t writes = 0;
+    uint16_t moves = 0;
+    uint8_t begins = 0;
+    CountingDisplay(uint8_t cols, uint8_t rows) : HeadlessDisplay(cols, rows) {}
+    void begin() override {
+        begins++;
+        HeadlessDisplay::begin();
+    }
+    void draw(uint8_t byte) override {
+        writes++;
+        HeadlessDisplay::draw(byte);
+    }
+    void setCursor(uint8_t col, uint8_t row) override {
+        moves++;
+        HeadlessDisplay::setCursor(col, row);
+    }
+};
+
+/**
+ * Start the renderer and show `screen` with the cursor on its first item.
+ */
+inline void startMenu(MenuRenderer& renderer, LcdMenu& menu, MenuScreen* screen) {
+    renderer.begin();
+    menu.setScreen(screen);
+    menu.reset();
+}
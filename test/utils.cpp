@@ -1,5 +1,7 @@
 #include <ArduinoUnitTests.h>
 #include <utils/constants.h>
+#include <utils/latency.h>
+#include <utils/trace.h>
 #include <utils/utils.h>
 
 unittest(concat_same_strings) {
@@ -60,4 +62,101 @@ unittest(remove_partial_string) {
     assertEqual("Hello ", str);
 }
 
+class TracePrint : public Print {
+  public:
+    uint8_t buffer[64];
+    uint8_t length = 0;
+    int room = sizeof(buffer);
+    size_t write(uint8_t byte) override {
+        buffer[length++] = byte;
+        room--;
+        return 1;
+    }
+    int availableForWrite() override { return room; }
+};
+
+#define TRACE_EVENT_SIZE (1 + sizeof(uintptr_t) + 2 + 4)
+
+unittest(trace_records_and_flushes_events) {
+    TracePrint out;
+    const __FlashStringHelper* message = F("MenuScreen::down");
+    trace(message, 513);
+    trace(message, "Hi");
+    assertEqual(2, traceFlush(out));
+    assertEqual(2 * TRACE_EVENT_SIZE, out.length);
+    assertEqual(TRACE_SYNC, out.buffer[0]);
+    assertEqual((uintptr_t)message & 0xFF, out.buffer[1]);
+    assertEqual(1, out.buffer[1 + sizeof(uintptr_t)]);
+    assertEqual(2, out.buffer[2 + sizeof(uintptr_t)]);
+    assertEqual('H', out.buffer[TRACE_EVENT_SIZE + 1 + sizeof(uintptr_t)]);
+    assertEqual(0, traceFlush(out));
+}
+
+unittest(trace_flush_never_blocks) {
+    TracePrint out;
+    out.room = TRACE_EVENT_SIZE + 1;
+    trace(F("a"));
+    trace(F("b"));
+    assertEqual(1, traceFlush(out));
+    out.room = sizeof(out.buffer) - out.length;
+    assertEqual(1, traceFlush(out));
+}
+
+unittest(trace_counts_dropped_events) {
+    TracePrint out;
+    for (uint8_t i = 0; i < TRACE_BUFFER_SIZE + 2; i++) {
+        trace(F("a"), i);
+    }
+    out.room = TRACE_EVENT_SIZE;
+    traceFlush(out);
+    // Overflow marker with id 0 and number of dropped events
+    assertEqual(0, out.buffer[1]);
+    assertEqual(3, out.buffer[1 + sizeof(uintptr_t)]);
+    do {
+        out.length = 0;
+        out.room = sizeof(out.buffer);
+    } while (traceFlush(out) > 0);
+}
+
+unittest(latency_histogram_percentiles) {
+    LatencyHistogram histogram;
+    assertEqual(0, histogram.getMin());
+    assertEqual(0, histogram.getPercentile(99));
+    for (uint8_t i = 0; i < 99; i++) {
+        histogram.record(10);
+    }
+    histogram.record(5000);
+    assertEqual(100, histogram.getCount());
+    assertEqual(10, histogram.getMin());
+    assertEqual(5000, histogram.getMax());
+    assertEqual(99, histogram.getBucket(3));
+    assertEqual(1, histogram.getBucket(12));
+    // Upper bound of the bucket [8, 16)
+    assertEqual(15, histogram.getPercentile(99));
+    assertEqual(5000, histogram.getPercentile(100));
+    histogram.record(UINT32_MAX);
+    assertEqual(1, histogram.getBucket(LATENCY_BUCKETS - 1));
+    histogram.reset();
+    assertEqual(0, histogram.getCount());
+}
+
+unittest(latency_observe_records_only_commands) {
+    latencyReset();
+    {
+        // Idle poll
+        LatencyObserveScope scope;
+    }
+    assertEqual(0, latencyHistogram(LATENCY_OBSERVE).getCount());
+    {
+        LatencyObserveScope scope;
+        latencyCommandObserved() = true;
+    }
+    assertEqual(1, latencyHistogram(LATENCY_OBSERVE).getCount());
+    {
+        LatencyObserveScope scope;
+    }
+    assertEqual(1, latencyHistogram(LATENCY_OBSERVE).getCount());
+    latencyReset();
+}
+
 unittest_main()
\ No newline at end of file